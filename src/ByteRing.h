@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(BYTE_RING_SIZE)
+#define BYTE_RING_SIZE 256
+#endif
+
+
+/*!
+Lock free single producer, single consumer ring of bytes.
+
+Used to split receiving from parsing across cores: the UART ISR, on one core, pushes the received bytes,
+and the receiver task, on the other core, pops and parses them.
+
+The producer's and consumer's indices are on separate cache lines, so the cores do not contend for them.
+If the ring is full, the new byte is discarded and counted as an overflow.
+*/
+class ByteRing {
+public:
+    enum { SIZE = BYTE_RING_SIZE };
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "BYTE_RING_SIZE must be a power of 2");
+public:
+    ByteRing() = default;
+private:
+    // ByteRing is not copyable or moveable
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+    ByteRing(ByteRing&&) = delete;
+    ByteRing& operator=(ByteRing&&) = delete;
+public:
+    //! called by the producer, returns false if the ring is full
+    bool push(uint8_t data) {
+        const uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= SIZE) {
+            _overflowCount.store(_overflowCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        _buffer[head & (SIZE - 1)] = data;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    //! called by the consumer, returns false if the ring is empty
+    bool pop(uint8_t& data) {
+        const uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        data = _buffer[tail & (SIZE - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    size_t available() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+    bool empty() const { return available() == 0; }
+    uint32_t getOverflowCount() const { return _overflowCount.load(std::memory_order_relaxed); }
+private:
+    alignas(64) std::atomic<uint32_t> _head {}; //!< written by the producer
+    std::atomic<uint32_t> _overflowCount {};
+    alignas(64) std::atomic<uint32_t> _tail {}; //!< written by the consumer
+    alignas(64) std::array<uint8_t, SIZE> _buffer {};
+};
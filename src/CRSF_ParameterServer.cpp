@@ -0,0 +1,250 @@
+#include "CRSF_ParameterServer.h"
+#include "ReceiverCRSF.h"
+
+static_assert(CRSF_ParameterServer::MAX_FRAME_SIZE == ReceiverCRSF::MAX_PACKET_SIZE);
+
+
+CRSF_ParameterServer::CRSF_ParameterServer(const device_info_t& deviceInfo, const parameter_t* parameters, size_t parameterCount, CRSF_ParameterWatcher* watcher) :
+    _deviceInfo(deviceInfo),
+    _parameters(parameters),
+    _parameterCount(parameterCount),
+    _watcher(watcher)
+{
+}
+
+/*!
+Appends a zero terminated string, truncating it if necessary so it fits in an entry.
+*/
+size_t CRSF_ParameterServer::packString(uint8_t* buf, size_t pos, const char* str)
+{
+    if (str != nullptr) {
+        while (*str != '\0' && pos < MAX_ENTRY_SIZE - 1) {
+            buf[pos++] = static_cast<uint8_t>(*str++); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+    if (pos < MAX_ENTRY_SIZE) {
+        buf[pos++] = 0;
+    }
+    return pos;
+}
+
+/*!
+Appends a big-endian value of `size` bytes, if there is room in the entry.
+*/
+size_t CRSF_ParameterServer::packValue(uint8_t* buf, size_t pos, int32_t value, size_t size)
+{
+    if (pos + size > MAX_ENTRY_SIZE) {
+        return pos;
+    }
+    for (size_t ii = size; ii > 0; --ii) {
+        buf[pos++] = static_cast<uint8_t>(static_cast<uint32_t>(value) >> (8*(ii - 1))); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return pos;
+}
+
+/*!
+Sets the length and CRC of a frame whose payload (ie the bytes after the frame type) has already been filled in.
+
+Returns the total length of the frame.
+*/
+size_t CRSF_ParameterServer::finalizeFrame(frame_t& frame, size_t payloadLength)
+{
+    frame[0] = ReceiverCRSF::CRSF_SYNC_BYTE;
+    frame[1] = static_cast<uint8_t>(payloadLength + 2); // length is length of type, payload, and CRC
+    uint8_t crc = 0;
+    for (size_t ii = 2; ii < payloadLength + 3; ++ii) {
+        crc = ReceiverCRSF::calculateCRC(crc, frame[ii]);
+    }
+    frame[payloadLength + 3] = crc;
+    return payloadLength + 4;
+}
+
+/*!
+Packs the settings entry for parameter `index` into `entry`, which must have room for MAX_ENTRY_SIZE bytes.
+
+Index 0 is the root folder. Returns the length of the entry, or zero if there is no such parameter.
+*/
+size_t CRSF_ParameterServer::packEntry(size_t index, uint8_t* entry) const
+{
+    if (index > _parameterCount) {
+        return 0;
+    }
+
+    static constexpr parameter_t root { .parent = 0, .type = TYPE_FOLDER, .name = nullptr, .options = nullptr, .units = nullptr, .min = 0, .max = 0, .defaultValue = 0, .decimalPoint = 0, .step = 0 };
+    const parameter_t& parameter = (index == 0) ? root : _parameters[index - 1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const int32_t value = (_watcher != nullptr && index != 0) ? _watcher->getParameterValue(index) : parameter.defaultValue;
+
+    size_t pos = 0;
+    entry[pos++] = parameter.parent; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    entry[pos++] = parameter.type; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    pos = packString(entry, pos, (index == 0) ? _deviceInfo.name : parameter.name);
+
+    switch (parameter.type & static_cast<uint8_t>(~TYPE_HIDDEN)) {
+    case TYPE_UINT8:
+    case TYPE_INT8:
+        pos = packValue(entry, pos, value, 1);
+        pos = packValue(entry, pos, parameter.min, 1);
+        pos = packValue(entry, pos, parameter.max, 1);
+        pos = packString(entry, pos, parameter.units);
+        break;
+    case TYPE_UINT16:
+    case TYPE_INT16:
+        pos = packValue(entry, pos, value, 2);
+        pos = packValue(entry, pos, parameter.min, 2);
+        pos = packValue(entry, pos, parameter.max, 2);
+        pos = packString(entry, pos, parameter.units);
+        break;
+    case TYPE_FLOAT:
+        pos = packValue(entry, pos, value, 4);
+        pos = packValue(entry, pos, parameter.min, 4);
+        pos = packValue(entry, pos, parameter.max, 4);
+        pos = packValue(entry, pos, parameter.defaultValue, 4);
+        pos = packValue(entry, pos, parameter.decimalPoint, 1);
+        pos = packValue(entry, pos, parameter.step, 4);
+        pos = packString(entry, pos, parameter.units);
+        break;
+    case TYPE_TEXT_SELECTION:
+        pos = packString(entry, pos, parameter.options);
+        pos = packValue(entry, pos, value, 1);
+        pos = packValue(entry, pos, parameter.min, 1);
+        pos = packValue(entry, pos, parameter.max, 1);
+        pos = packValue(entry, pos, parameter.defaultValue, 1);
+        pos = packString(entry, pos, parameter.units);
+        break;
+    case TYPE_STRING:
+    case TYPE_INFO:
+        pos = packString(entry, pos, parameter.options);
+        break;
+    case TYPE_FOLDER: {
+        // list of children, terminated by 0xFF
+        enum { END_OF_CHILDREN = 0xFF };
+        for (size_t ii = 0; ii < _parameterCount && pos < MAX_ENTRY_SIZE - 1; ++ii) {
+            if (_parameters[ii].parent == index && ii + 1 != index) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                entry[pos++] = static_cast<uint8_t>(ii + 1); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+        pos = packValue(entry, pos, END_OF_CHILDREN, 1);
+        break;
+    }
+    case TYPE_COMMAND: {
+        enum { COMMAND_TIMEOUT_TENTHS_OF_SECOND = 10 };
+        pos = packValue(entry, pos, value, 1); // command status
+        pos = packValue(entry, pos, COMMAND_TIMEOUT_TENTHS_OF_SECOND, 1);
+        pos = packString(entry, pos, parameter.options);
+        break;
+    }
+    default:
+        break;
+    }
+    return pos;
+}
+
+size_t CRSF_ParameterServer::packDeviceInfo(uint8_t destination, frame_t& response) const
+{
+    static constexpr size_t MAX_NAME_LENGTH = MAX_FRAME_SIZE - 21; // leave room for header, zero terminator, ids, counts, and CRC
+
+    size_t pos = 2;
+    response[pos++] = ReceiverCRSF::FRAMETYPE_DEVICE_INFO;
+    response[pos++] = destination;
+    response[pos++] = ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER;
+    const char* name = _deviceInfo.name;
+    for (size_t ii = 0; name != nullptr && name[ii] != '\0' && ii < MAX_NAME_LENGTH; ++ii) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        response[pos++] = static_cast<uint8_t>(name[ii]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    response[pos++] = 0;
+    pos = packValue(&response[0], pos, static_cast<int32_t>(_deviceInfo.serialNumber), 4);
+    pos = packValue(&response[0], pos, static_cast<int32_t>(_deviceInfo.hardwareId), 4);
+    pos = packValue(&response[0], pos, static_cast<int32_t>(_deviceInfo.firmwareId), 4);
+    response[pos++] = static_cast<uint8_t>(_parameterCount);
+    response[pos++] = PROTOCOL_VERSION;
+
+    return finalizeFrame(response, pos - 3);
+}
+
+size_t CRSF_ParameterServer::packEntryChunk(uint8_t destination, size_t index, size_t chunk, frame_t& response) const
+{
+    std::array<uint8_t, MAX_ENTRY_SIZE> entry {};
+    const size_t entryLength = packEntry(index, &entry[0]);
+    if (entryLength == 0) {
+        return 0;
+    }
+    const size_t chunkCount = (entryLength + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (chunk >= chunkCount) {
+        return 0;
+    }
+    const size_t chunkStart = chunk * CHUNK_SIZE;
+    const size_t chunkLength = (entryLength - chunkStart < CHUNK_SIZE) ? entryLength - chunkStart : CHUNK_SIZE;
+
+    size_t pos = 2;
+    response[pos++] = ReceiverCRSF::FRAMETYPE_PARAMETER_SETTINGS_ENTRY;
+    response[pos++] = destination;
+    response[pos++] = ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER;
+    response[pos++] = static_cast<uint8_t>(index);
+    response[pos++] = static_cast<uint8_t>(chunkCount - chunk - 1); // chunks remaining
+    for (size_t ii = 0; ii < chunkLength; ++ii) {
+        response[pos++] = entry[chunkStart + ii];
+    }
+
+    return finalizeFrame(response, pos - 3);
+}
+
+/*!
+Processes an extended frame, `payload` starts with the destination and origin addresses and excludes the CRC.
+
+Builds at most one response frame. Returns the length of the response, or zero if there is no response.
+*/
+size_t CRSF_ParameterServer::processFrame(uint8_t frameType, const uint8_t* payload, size_t payloadLength, frame_t& response)
+{
+    if (payloadLength < 2) {
+        return 0;
+    }
+    const uint8_t destination = payload[0];
+    const uint8_t origin = payload[1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    switch (frameType) {
+    case ReceiverCRSF::FRAMETYPE_DEVICE_PING:
+        if (destination == ReceiverCRSF::ADDRESS_BROADCAST || destination == ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER) {
+            return packDeviceInfo(origin, response);
+        }
+        return 0;
+    case ReceiverCRSF::FRAMETYPE_PARAMETER_READ:
+        // payload is destination, origin, parameter index, chunk number
+        if (destination == ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER && payloadLength >= 4) {
+            return packEntryChunk(origin, payload[2], payload[3], response); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        return 0;
+    case ReceiverCRSF::FRAMETYPE_PARAMETER_WRITE: {
+        // payload is destination, origin, parameter index, value (big-endian, size depends on type)
+        if (destination != ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER || payloadLength < 4) {
+            return 0;
+        }
+        const size_t index = payload[2]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (index == 0 || index > _parameterCount) {
+            return 0;
+        }
+        const uint8_t type = _parameters[index - 1].type & static_cast<uint8_t>(~TYPE_HIDDEN); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const size_t valueSize =
+            (type == TYPE_UINT16 || type == TYPE_INT16) ? 2 :
+            (type == TYPE_FLOAT) ? 4 :
+            (type == TYPE_FOLDER || type == TYPE_INFO || type == TYPE_STRING) ? 0 : 1;
+        if (valueSize == 0 || payloadLength < 3 + valueSize) {
+            return 0;
+        }
+        uint32_t value = 0;
+        for (size_t ii = 0; ii < valueSize; ++ii) {
+            value = (value << 8U) | payload[3 + ii]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        // sign extend
+        const int32_t signedValue =
+            (type == TYPE_INT8) ? static_cast<int8_t>(value) :
+            (type == TYPE_INT16) ? static_cast<int16_t>(value) : static_cast<int32_t>(value);
+        if (_watcher != nullptr) {
+            _watcher->setParameterValue(index, signedValue);
+        }
+        // respond with the updated entry
+        return packEntryChunk(origin, index, 0, response);
+    }
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+/*!
+Interface used by the parameter server to get and set parameter values.
+
+`index` is the parameter number, which starts at 1.
+*/
+class CRSF_ParameterWatcher {
+public:
+    virtual ~CRSF_ParameterWatcher() = default;
+    virtual int32_t getParameterValue(size_t index) const = 0;
+    virtual void setParameterValue(size_t index, int32_t value) = 0;
+};
+
+
+/*!
+Server for the CRSF device ping and parameter protocol.
+
+Answers DEVICE_PING with DEVICE_INFO, and serves entries from a constant parameter table as PARAMETER_SETTINGS_ENTRY chunks.
+
+Each request produces at most one response frame, and each entry is bounded by MAX_ENTRY_SIZE,
+so the cost of processing a received frame is bounded.
+
+Parameters are numbered from 1, parameter 0 is the root folder.
+*/
+class CRSF_ParameterServer {
+public:
+    enum type_e : uint8_t {
+        TYPE_UINT8 = 0,
+        TYPE_INT8 = 1,
+        TYPE_UINT16 = 2,
+        TYPE_INT16 = 3,
+        TYPE_FLOAT = 8,
+        TYPE_TEXT_SELECTION = 9,
+        TYPE_STRING = 10,
+        TYPE_FOLDER = 11,
+        TYPE_INFO = 12,
+        TYPE_COMMAND = 13,
+        TYPE_HIDDEN = 0x80
+    };
+    struct parameter_t {
+        uint8_t parent; //!< index of parent folder, 0 for root
+        uint8_t type;
+        const char* name;
+        const char* options; //!< semicolon separated options for TYPE_TEXT_SELECTION, text for TYPE_STRING and TYPE_INFO, info for TYPE_COMMAND
+        const char* units;
+        int32_t min;
+        int32_t max;
+        int32_t defaultValue;
+        uint8_t decimalPoint; //!< TYPE_FLOAT only
+        int32_t step; //!< TYPE_FLOAT only
+    };
+    struct device_info_t {
+        const char* name;
+        uint32_t serialNumber;
+        uint32_t hardwareId;
+        uint32_t firmwareId;
+    };
+    static constexpr size_t MAX_FRAME_SIZE = 64;
+    static constexpr size_t CHUNK_SIZE = MAX_FRAME_SIZE - 8; // sync, length, type, destination, origin, index, chunks remaining, and CRC bytes
+    static constexpr size_t MAX_ENTRY_SIZE = 2 * CHUNK_SIZE;
+    enum { PROTOCOL_VERSION = 0 };
+    typedef std::array<uint8_t, MAX_FRAME_SIZE> frame_t;
+public:
+    CRSF_ParameterServer(const device_info_t& deviceInfo, const parameter_t* parameters, size_t parameterCount, CRSF_ParameterWatcher* watcher);
+private:
+    // CRSF_ParameterServer is not copyable or moveable
+    CRSF_ParameterServer(const CRSF_ParameterServer&) = delete;
+    CRSF_ParameterServer& operator=(const CRSF_ParameterServer&) = delete;
+    CRSF_ParameterServer(CRSF_ParameterServer&&) = delete;
+    CRSF_ParameterServer& operator=(CRSF_ParameterServer&&) = delete;
+public:
+    size_t getParameterCount() const { return _parameterCount; }
+    size_t processFrame(uint8_t frameType, const uint8_t* payload, size_t payloadLength, frame_t& response);
+    size_t packEntry(size_t index, uint8_t* entry) const;
+private:
+    size_t packDeviceInfo(uint8_t destination, frame_t& response) const;
+    size_t packEntryChunk(uint8_t destination, size_t index, size_t chunk, frame_t& response) const;
+    static size_t packString(uint8_t* buf, size_t pos, const char* str);
+    static size_t packValue(uint8_t* buf, size_t pos, int32_t value, size_t size);
+    static size_t finalizeFrame(frame_t& frame, size_t payloadLength);
+private:
+    const device_info_t _deviceInfo;
+    const parameter_t* _parameters;
+    const size_t _parameterCount;
+    CRSF_ParameterWatcher* _watcher;
+};
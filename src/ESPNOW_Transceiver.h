@@ -1,5 +1,7 @@
 # pragma once
 
+#include "TaskSignal.h"
+
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -10,7 +12,7 @@
 #include <esp_attr.h>
 #include <esp_now.h>
 #include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
+#include <freertos/task.h>
 
 #else
 
@@ -97,36 +99,16 @@ private:
     std::array<uint8_t, ESP_NOW_ETH_ALEN + 2> _myMacAddress {0, 0, 0, 0, 0, 0, 0, 0};
 
 #if defined(LIBRARY_RECEIVER_USE_ESPNOW) && defined(FRAMEWORK_USE_FREERTOS)
-    enum { DATA_RECEIVED_QUEUE_LENGTH = 1}; // length MUST be 1 to be used by xQueueOverwriteFromISR
-
-    uint32_t _primaryDataReceivedQueueItem {}; // this is just a dummy item whose value is not used
-    BaseType_t _primaryDataReceivedQueueHigherPriorityTaskWoken = pdFALSE;
-    std::array<uint8_t, DATA_RECEIVED_QUEUE_LENGTH * sizeof(_primaryDataReceivedQueueItem)> _primaryDataReceivedQueueStorageArea {};
-    StaticQueue_t _primaryDataReceivedQueueStatic {};
-    QueueHandle_t _primaryDataReceivedQueue {};
-
-    uint32_t _secondaryDataReceivedQueueItem {}; // this is just a dummy item whose value is not used
-    BaseType_t _secondaryDataReceivedQueueHigherPriorityTaskWoken = pdFALSE;
-    std::array<uint8_t, DATA_RECEIVED_QUEUE_LENGTH * sizeof(_secondaryDataReceivedQueueItem)> _secondaryDataReceivedQueueStorageArea {};
-    StaticQueue_t _secondaryDataReceivedQueueStatic {};
-    QueueHandle_t _secondaryDataReceivedQueue {};
+    TaskSignal _primaryDataReceived;
+    TaskSignal _secondaryDataReceived;
 public:
-    inline int32_t WAIT_FOR_PRIMARY_DATA_RECEIVED() { return xQueueReceive(_primaryDataReceivedQueue, &_primaryDataReceivedQueueItem, portMAX_DELAY); }
-    inline int32_t WAIT_FOR_PRIMARY_DATA_RECEIVED(uint32_t ticksToWait) { return xQueueReceive(_primaryDataReceivedQueue, &_primaryDataReceivedQueueItem, ticksToWait); }
-    //inline void SIGNAL_PRIMARY_DATA_RECEIVED_FROM_ISR() { xQueueSendFromISR(_primaryDataReceivedQueue, &_primaryDataReceivedQueueItem, nullptr); }
-    inline void SIGNAL_PRIMARY_DATA_RECEIVED_FROM_ISR() {
-        _primaryDataReceivedQueueHigherPriorityTaskWoken = pdFALSE;
-        xQueueOverwriteFromISR(_primaryDataReceivedQueue, &_primaryDataReceivedQueueItem, &_primaryDataReceivedQueueHigherPriorityTaskWoken);
-        portYIELD_FROM_ISR(_primaryDataReceivedQueueHigherPriorityTaskWoken); // or portEND_SWITCHING_ISR() depending on the port.
-    }
-    inline int32_t WAIT_FOR_SECONDARY_DATA_RECEIVED() { return xQueueReceive(_secondaryDataReceivedQueue, &_secondaryDataReceivedQueueItem, portMAX_DELAY); }
-    inline int32_t WAIT_FOR_SECONDARY_DATA_RECEIVED(uint32_t ticksToWait) { return xQueueReceive(_secondaryDataReceivedQueue, &_secondaryDataReceivedQueueItem, ticksToWait); }
-    //inline void SIGNAL_SECONDARY_DATA_RECEIVED_FROM_ISR() { xQueueSendFromISR(_secondaryDataReceivedQueue, &_secondaryDataReceivedQueueItem, nullptr); }
-    inline void SIGNAL_SECONDARY_DATA_RECEIVED_FROM_ISR() {
-        _secondaryDataReceivedQueueHigherPriorityTaskWoken = pdFALSE;
-        xQueueOverwriteFromISR(_secondaryDataReceivedQueue, &_secondaryDataReceivedQueueItem, &_secondaryDataReceivedQueueHigherPriorityTaskWoken);
-        portYIELD_FROM_ISR(_secondaryDataReceivedQueueHigherPriorityTaskWoken); // or portEND_SWITCHING_ISR() depending on the port.
-    }
+    // the WAIT functions return the number of packets received since the last wait, 0 if timeout
+    inline int32_t WAIT_FOR_PRIMARY_DATA_RECEIVED() { return _primaryDataReceived.WAIT(TaskSignal::WAIT_FOREVER); }
+    inline int32_t WAIT_FOR_PRIMARY_DATA_RECEIVED(uint32_t ticksToWait) { return _primaryDataReceived.WAIT(ticksToWait); }
+    inline void SIGNAL_PRIMARY_DATA_RECEIVED_FROM_ISR() { _primaryDataReceived.SIGNAL_FROM_ISR(); }
+    inline int32_t WAIT_FOR_SECONDARY_DATA_RECEIVED() { return _secondaryDataReceived.WAIT(TaskSignal::WAIT_FOREVER); }
+    inline int32_t WAIT_FOR_SECONDARY_DATA_RECEIVED(uint32_t ticksToWait) { return _secondaryDataReceived.WAIT(ticksToWait); }
+    inline void SIGNAL_SECONDARY_DATA_RECEIVED_FROM_ISR() { _secondaryDataReceived.SIGNAL_FROM_ISR(); }
 #else
 public:
     inline int32_t WAIT_FOR_PRIMARY_DATA_RECEIVED() { return 0; }
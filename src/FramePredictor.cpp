@@ -0,0 +1,126 @@
+#include "FramePredictor.h"
+
+
+void FramePredictor::reset()
+{
+    if (_locked) {
+        ++_unlockCount;
+    }
+    _locked = false;
+    _periodUs = 0;
+    _jitterUs = 0;
+    _frameCount = 0;
+    _consistentFrameCount = 0;
+    _consecutiveMissCount = 0;
+}
+
+/*!
+The guard is the time before and after the expected frame time that the task waits for the frame.
+Until the jitter has been measured, the initial guard is used, this should be the polling interval used while learning.
+*/
+uint32_t FramePredictor::getGuardUs() const
+{
+    const uint32_t guardUs = _consistentFrameCount < LOCK_FRAME_COUNT ? _initialGuardUs : 2 * _jitterUs + MIN_GUARD_US;
+    // guard must be less than half the period, otherwise the wake window would overlap the previous frame
+    return (_periodUs != 0 && guardUs > _periodUs / 2) ? _periodUs / 2 : guardUs;
+}
+
+/*!
+Records the arrival time of a frame.
+
+While learning, the period is the average interval since learning started, so the error in frame times (which are only as
+accurate as the polling interval) is averaged out. An interval that is not consistent with the period restarts learning.
+
+Once locked, frames are compared with the expected time, allowing for frames that were missed, and the period is filtered so that it can track slow drift.
+A frame that arrives too far from the expected time is counted as an outlier, and the phase is kept.
+After MAX_CONSECUTIVE_MISSES outliers in a row, learning restarts.
+*/
+void FramePredictor::onFrame(timeUs32_t frameTimeUs)
+{
+    enum { PERIOD_FILTER_SHIFT = 3, JITTER_FILTER_SHIFT = 3 };
+
+    const uint32_t intervalUs = frameTimeUs - _lastFrameTimeUs;
+    if (_locked) {
+        const auto periodUs = static_cast<int32_t>(_periodUs);
+        const auto arrivalErrorUs = static_cast<int32_t>(frameTimeUs - _expectedTimeUs);
+        // frames that were missed, without onMiss() being called, make the frame arrive a whole number of periods late
+        const int32_t skippedFrameCount = arrivalErrorUs > periodUs / 2 ? (arrivalErrorUs + periodUs / 2) / periodUs : 0;
+        const int32_t residualErrorUs = arrivalErrorUs - skippedFrameCount * periodUs;
+        if (residualErrorUs > -periodUs / 4 && residualErrorUs < periodUs / 4 && skippedFrameCount < MAX_MULTIPLE) {
+            const auto periodCount = static_cast<int32_t>((intervalUs + _periodUs / 2) / _periodUs);
+            _periodUs = static_cast<uint32_t>(periodUs + residualErrorUs / ((periodCount < 1 ? 1 : periodCount) << PERIOD_FILTER_SHIFT));
+            const auto absoluteErrorUs = static_cast<uint32_t>(residualErrorUs < 0 ? -residualErrorUs : residualErrorUs);
+            _jitterUs = static_cast<uint32_t>(static_cast<int32_t>(_jitterUs) + (static_cast<int32_t>(absoluteErrorUs) - static_cast<int32_t>(_jitterUs)) / (1 << JITTER_FILTER_SHIFT));
+            _consecutiveOutlierCount = 0;
+        } else if (_consecutiveOutlierCount < MAX_CONSECUTIVE_MISSES - 1) {
+            // a single late or early frame, for example because the task was delayed, is ignored
+            ++_consecutiveOutlierCount;
+            ++_outlierCount;
+            _lastFrameTimeUs = frameTimeUs;
+            _expectedTimeUs += _periodUs;
+            _consecutiveMissCount = 0;
+            return;
+        } else {
+            restartLearning(intervalUs);
+        }
+    } else if (_frameCount > 0) {
+        // while learning, a missed frame restarts learning, otherwise the predictor could lock to a fraction of the true period
+        const uint32_t multiple = _periodUs == 0 ? 0 : (intervalUs + _periodUs / 2) / _periodUs;
+        const auto intervalErrorUs = static_cast<int32_t>(intervalUs - _periodUs);
+        // frame times are only as accurate as the polling interval, so allow for that
+        const auto maxIntervalErrorUs = static_cast<int32_t>(_periodUs / 4 + _initialGuardUs);
+        if (multiple == 1 && intervalErrorUs > -maxIntervalErrorUs && intervalErrorUs < maxIntervalErrorUs) {
+            ++_learningPeriodCount;
+            _periodUs = (frameTimeUs - _learningStartTimeUs) / _learningPeriodCount;
+            const auto arrivalErrorUs = static_cast<int32_t>(frameTimeUs - _expectedTimeUs);
+            const auto absoluteErrorUs = static_cast<uint32_t>(arrivalErrorUs < 0 ? -arrivalErrorUs : arrivalErrorUs);
+            _jitterUs = static_cast<uint32_t>(static_cast<int32_t>(_jitterUs) + (static_cast<int32_t>(absoluteErrorUs) - static_cast<int32_t>(_jitterUs)) / (1 << JITTER_FILTER_SHIFT));
+            ++_consistentFrameCount;
+        } else {
+            restartLearning(intervalUs);
+        }
+    }
+    if (_periodUs < MIN_PERIOD_US || _periodUs > MAX_PERIOD_US) {
+        _periodUs = 0;
+        _consistentFrameCount = 0;
+        _locked = false;
+    }
+    ++_frameCount;
+    _lastFrameTimeUs = frameTimeUs;
+    _expectedTimeUs = frameTimeUs + _periodUs;
+    _consecutiveMissCount = 0;
+    if (_consistentFrameCount >= LOCK_FRAME_COUNT) {
+        _locked = true;
+    }
+}
+
+/*!
+Restarts learning, with intervalUs as the first estimate of the period.
+*/
+void FramePredictor::restartLearning(uint32_t intervalUs)
+{
+    if (_locked) {
+        ++_unlockCount;
+    }
+    _locked = false;
+    _periodUs = intervalUs;
+    _jitterUs = 0;
+    _learningStartTimeUs = _lastFrameTimeUs;
+    _learningPeriodCount = 1;
+    _consistentFrameCount = 1;
+    _consecutiveOutlierCount = 0;
+}
+
+/*!
+Called when no frame arrived by the deadline. The next frame is expected one period later.
+After MAX_CONSECUTIVE_MISSES the predictor unlocks.
+*/
+void FramePredictor::onMiss()
+{
+    ++_missCount;
+    ++_consecutiveMissCount;
+    _expectedTimeUs += _periodUs;
+    if (_consecutiveMissCount >= MAX_CONSECUTIVE_MISSES) {
+        reset();
+    }
+}
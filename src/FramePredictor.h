@@ -0,0 +1,54 @@
+#pragma once
+
+#include <TimeMicroseconds.h>
+#include <cstdint>
+
+
+/*!
+Learns the period and phase of a receiver's frames from their arrival times, and predicts when the next frame will arrive.
+
+Used for predictive wake scheduling: the task sleeps until just before the next frame is expected, and then waits for the frame,
+up to a deadline just after the frame is expected. The wake window is twice the measured jitter, plus a margin.
+
+Frames must arrive with a consistent period LOCK_FRAME_COUNT times in succession before the predictor is locked.
+After MAX_CONSECUTIVE_MISSES missed frames, or that many frames in a row that arrive too far from the expected time, the predictor unlocks and must relearn the period and phase.
+*/
+class FramePredictor {
+public:
+    enum { LOCK_FRAME_COUNT = 8, MAX_CONSECUTIVE_MISSES = 3 };
+    enum { MIN_PERIOD_US = 500, MAX_PERIOD_US = 100000, MIN_GUARD_US = 200, MAX_MULTIPLE = 8 };
+public:
+    explicit FramePredictor(uint32_t initialGuardUs) : _initialGuardUs(initialGuardUs) {}
+    void reset();
+    void onFrame(timeUs32_t frameTimeUs);
+    void onMiss();
+
+    bool isLocked() const { return _locked; }
+    uint32_t getPeriodUs() const { return _periodUs; }
+    uint32_t getJitterUs() const { return _jitterUs; }
+    uint32_t getGuardUs() const;
+    timeUs32_t getExpectedTimeUs() const { return _expectedTimeUs; }
+    timeUs32_t getWakeTimeUs() const { return _expectedTimeUs - getGuardUs(); } //!< time to wake, just before the next frame is expected
+    timeUs32_t getDeadlineUs() const { return _expectedTimeUs + getGuardUs(); } //!< if no frame by this time, then the frame is counted as missed
+    uint32_t getMissCount() const { return _missCount; }
+    uint32_t getUnlockCount() const { return _unlockCount; }
+    uint32_t getOutlierCount() const { return _outlierCount; }
+private:
+    void restartLearning(uint32_t intervalUs);
+private:
+    uint32_t _initialGuardUs;
+    uint32_t _periodUs {};
+    uint32_t _jitterUs {};
+    timeUs32_t _lastFrameTimeUs {};
+    timeUs32_t _expectedTimeUs {};
+    timeUs32_t _learningStartTimeUs {};
+    uint32_t _learningPeriodCount {};
+    uint32_t _frameCount {};
+    uint32_t _consistentFrameCount {};
+    uint32_t _consecutiveMissCount {};
+    uint32_t _missCount {};
+    uint32_t _unlockCount {};
+    uint32_t _consecutiveOutlierCount {};
+    uint32_t _outlierCount {};
+    bool _locked {false};
+};
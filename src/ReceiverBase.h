@@ -9,6 +9,8 @@ public:
     virtual void newReceiverPacketAvailable() = 0;
 };
 
+class ReceiverSubscribers;
+
 /*!
 Abstract Base Class defining a receiver.
 */
@@ -85,11 +87,28 @@ public:
         uint8_t startStep;
         uint8_t endStep;
     };
+    /*!
+    Receive path error statistics, used to tell a noisy or misconfigured line from a receiver task that is not keeping up.
+    The UART counts are read from the UART hardware, so are only available on platforms where the SerialPort reports them.
+    */
+    struct error_statistics_t {
+        uint32_t uartOverrunCount; //!< bytes lost because the UART receive buffer was full
+        uint32_t uartFramingErrorCount;
+        uint32_t uartParityErrorCount;
+        uint32_t crcErrorCount; //!< complete frames rejected because of a bad CRC or checksum
+        uint32_t badSyncByteCount; //!< bytes that should have been a sync byte or a valid header byte, but were not
+        uint32_t truncatedFrameCount; //!< partially received frames discarded because the inter-byte timeout expired
+        uint32_t resyncCount; //!< frames received after frame sync was lost because of bad sync bytes
+        uint32_t discardedByteCount; //!< bytes discarded because of bad sync bytes and truncated frames
+    };
 public:
     virtual ~ReceiverBase() = default;
 
     ReceiverWatcher* getReceiverWatcher() const { return _receiverWatcher; }
     void setReceiverWatcher(ReceiverWatcher* receiverWatcher) { _receiverWatcher = receiverWatcher; }
+    //! subscribers are published a snapshot by the ReceiverTask each time a new packet is received
+    ReceiverSubscribers* getReceiverSubscribers() const { return _receiverSubscribers; }
+    void setReceiverSubscribers(ReceiverSubscribers* receiverSubscribers) { _receiverSubscribers = receiverSubscribers; }
     void setPositiveHalfThrottle(bool positiveHalfThrottle) { _positiveHalfThrottle = positiveHalfThrottle; }
 
     // 48-bit Extended Unique Identifiers, usually the MAC address if the receiver has one, but may be an alternative provided by the receiver.
@@ -142,8 +161,11 @@ public:
     inline void setSwitch(size_t index, uint8_t value) { _switches &= static_cast<uint32_t>(~(0b11U << (2*index))); _switches |= static_cast<uint32_t>((value & 0b11U) << (2*index)); }
     inline uint32_t getSwitches() const { return _switches; }
 
+    inline int32_t getPacketCount() const { return _packetCount; }
+    inline int32_t getDroppedPacketCount() const { return _droppedPacketCount; }
     inline int32_t getDroppedPacketCountDelta() const { return _droppedPacketCountDelta; }
     inline uint32_t getTickCountDelta() const { return _tickCountDelta; }
+    virtual error_statistics_t getErrorStatistics() const { return _errorStatistics; }
     inline static float Q12dot4_to_float(int32_t q4dot12) { return static_cast<float>(q4dot12) * (1.0F / 2048.0F); } //<! convert Q12dot4 fixed point number to floating point
 
     inline bool isPacketReceived() const { return _packetReceived; }
@@ -151,6 +173,7 @@ public:
     inline void clearNewPacketAvailable() { _newPacketAvailable = false; }
 protected:
     ReceiverWatcher* _receiverWatcher {nullptr};
+    ReceiverSubscribers* _receiverSubscribers {nullptr};
     uint8_t _packetReceived {false}; // may be invalid packet
     uint8_t _newPacketAvailable {false};
     uint8_t _positiveHalfThrottle {false};
@@ -159,6 +182,7 @@ protected:
     int32_t _droppedPacketCount {};
     int32_t _droppedPacketCountPrevious {};
     uint32_t _tickCountDelta {};
+    error_statistics_t _errorStatistics {};
     uint32_t _switches {}; // 16 2 or 3 positions switches, each using 2-bits
     controls_t _controls {}; //!< the main 4 channels
     uint32_t _auxiliaryChannelCount {};
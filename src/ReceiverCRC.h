@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+Table driven CRCs used by the receiver protocols.
+
+The tables are generated at compile time, so calculating a CRC costs one table lookup per byte.
+*/
+
+constexpr std::array<uint16_t, 256> crc16_makeTable(uint16_t polynomial)
+{
+    std::array<uint16_t, 256> table {};
+    for (size_t ii = 0; ii < table.size(); ++ii) {
+        auto crc = static_cast<uint16_t>(ii << 8U);
+        for (int jj = 0; jj < 8; ++jj) {
+            crc = (crc & 0x8000U) ? static_cast<uint16_t>((crc << 1U) ^ polynomial) : static_cast<uint16_t>(crc << 1U);
+        }
+        table[ii] = crc;
+    }
+    return table;
+}
+
+//! CRC16-CCITT, polynomial 0x1021, MSB first (as used by XMODEM)
+inline constexpr std::array<uint16_t, 256> crc16_CCITT_Table = crc16_makeTable(0x1021);
+
+inline uint16_t crc16_CCITT(uint16_t crc, uint8_t value)
+{
+    return static_cast<uint16_t>((crc << 8U) ^ crc16_CCITT_Table[((crc >> 8U) ^ value) & 0xFFU]);
+}
+
+inline uint16_t crc16_CCITT(uint16_t crc, const uint8_t* data, size_t length)
+{
+    for (size_t ii = 0; ii < length; ++ii) {
+        crc = crc16_CCITT(crc, data[ii]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return crc;
+}
+
+constexpr std::array<uint8_t, 256> crc8_makeTable(uint8_t polynomial)
+{
+    std::array<uint8_t, 256> table {};
+    for (size_t ii = 0; ii < table.size(); ++ii) {
+        auto crc = static_cast<uint8_t>(ii);
+        for (int jj = 0; jj < 8; ++jj) {
+            crc = (crc & 0x80U) ? static_cast<uint8_t>((crc << 1U) ^ polynomial) : static_cast<uint8_t>(crc << 1U);
+        }
+        table[ii] = crc;
+    }
+    return table;
+}
+
+//! CRC8 DVB-S2, polynomial 0xD5, MSB first (as used by CRSF and GHST)
+inline constexpr std::array<uint8_t, 256> crc8_DVB_S2_Table = crc8_makeTable(0xD5);
+
+inline uint8_t crc8_DVB_S2(uint8_t crc, uint8_t value)
+{
+    return crc8_DVB_S2_Table[crc ^ value];
+}
+
+inline uint8_t crc8_DVB_S2(uint8_t crc, const uint8_t* data, size_t length)
+{
+    for (size_t ii = 0; ii < length; ++ii) {
+        crc = crc8_DVB_S2(crc, data[ii]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return crc;
+}
+
+constexpr std::array<uint16_t, 256> crc16_makeReflectedTable(uint16_t reflectedPolynomial)
+{
+    std::array<uint16_t, 256> table {};
+    for (size_t ii = 0; ii < table.size(); ++ii) {
+        auto crc = static_cast<uint16_t>(ii);
+        for (int jj = 0; jj < 8; ++jj) {
+            crc = (crc & 0x0001U) ? static_cast<uint16_t>((crc >> 1U) ^ reflectedPolynomial) : static_cast<uint16_t>(crc >> 1U);
+        }
+        table[ii] = crc;
+    }
+    return table;
+}
+
+//! CRC16-CCITT reflected, polynomial 0x1021 (0x8408 reflected), LSB first (as used by KERMIT and Jeti EX Bus)
+inline constexpr std::array<uint16_t, 256> crc16_CCITT_ReflectedTable = crc16_makeReflectedTable(0x8408);
+
+inline uint16_t crc16_CCITT_Reflected(uint16_t crc, uint8_t value)
+{
+    return static_cast<uint16_t>((crc >> 8U) ^ crc16_CCITT_ReflectedTable[(crc ^ value) & 0xFFU]);
+}
+
+inline uint16_t crc16_CCITT_Reflected(uint16_t crc, const uint8_t* data, size_t length)
+{
+    for (size_t ii = 0; ii < length; ++ii) {
+        crc = crc16_CCITT_Reflected(crc, data[ii]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return crc;
+}
@@ -1,3 +1,5 @@
+#include "CRSF_ParameterServer.h"
+#include "ReceiverCRC.h"
 #include "ReceiverCRSF.h"
 
 
@@ -46,13 +48,13 @@ bool ReceiverCRSF::onDataReceivedFromISR(uint8_t data)
 {
     const timeUs32_t timeNowUs = timeUs();
     if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
-        _packetIndex = 0;
-        ++_droppedPacketCount;
+        onFrameTimeout();
     }
 
     switch (_packetIndex) {
     case 0:
         if (data != CRSF_SYNC_BYTE && data != EDGE_TX_SYNC_BYTE) {
+            onBadSyncByte();
             _packetIsEmpty = true;
             return false;
         }
@@ -72,6 +74,9 @@ bool ReceiverCRSF::onDataReceivedFromISR(uint8_t data)
         _packetIndex = 0;
         _packetSize = 0;
         _packet = _packetISR;
+        _packetStartTime = _startTime;
+        _packetIsEmpty = false;
+        onFrameComplete();
         return true;
     }
     return false;
@@ -79,17 +84,7 @@ bool ReceiverCRSF::onDataReceivedFromISR(uint8_t data)
 
 uint8_t ReceiverCRSF::calculateCRC(uint8_t crc, uint8_t value)
 {
-    static constexpr uint8_t POLYNOMIAL = 0xD5;
-
-    crc ^= value;
-    for (int ii = 0; ii < 8; ++ii) { // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-        const uint8_t topBit = crc & 0x80U;
-        crc <<= 1U;
-        if (topBit) {
-            crc ^= POLYNOMIAL;
-        }
-    }
-    return crc;
+    return crc8_DVB_S2(crc, value);
 }
 
 uint8_t ReceiverCRSF::calculateCRC() const
@@ -106,6 +101,71 @@ uint8_t ReceiverCRSF::getReceivedCRC() const
     return _packet.value.payload[_packet.value.length - 2];
 }
 
+/*!
+Passes device ping and parameter frames to the parameter server, if there is one, and sends any response.
+
+At most one response frame is sent per received frame, and RC channel frames never reach here,
+so the parameter protocol does not add to the cost of processing RC frames.
+*/
+bool ReceiverCRSF::processExtendedFrame()
+{
+    if (_parameterServer == nullptr) {
+        return false;
+    }
+    // payload length excludes the type and CRC bytes
+    const size_t payloadLength = _packet.value.length - 2;
+    const size_t responseLength = _parameterServer->processFrame(_packet.value.type, &_packet.value.payload[0], payloadLength, _response);
+    if (responseLength == 0) {
+        return false;
+    }
+    _serialPort.write(&_response[0], responseLength);
+    return true;
+}
+
+/*!
+Decodes an OpenTX/EdgeTX sync frame, which gives the transmitter's frame period and phase offset.
+
+The payload is destination, origin, subtype, rate, and offset. Rate and offset are big-endian and in units of 0.1 microseconds.
+*/
+bool ReceiverCRSF::processSyncFrame()
+{
+    const auto& payload = _packet.value.payload;
+    if (_packet.value.length < OPENTX_SYNC_PAYLOAD_SIZE + 2 || payload[2] != RADIO_ID_SUBTYPE_OPENTX_SYNC) {
+        return false;
+    }
+    const uint32_t rate = (static_cast<uint32_t>(payload[3]) << 24U) | (static_cast<uint32_t>(payload[4]) << 16U) | (static_cast<uint32_t>(payload[5]) << 8U) | payload[6];
+    const uint32_t offset = (static_cast<uint32_t>(payload[7]) << 24U) | (static_cast<uint32_t>(payload[8]) << 16U) | (static_cast<uint32_t>(payload[9]) << 8U) | payload[10];
+    _syncFramePeriodUs = rate / 10;
+    _phaseOffsetUs = static_cast<int32_t>(offset) / 10;
+    if (_frameTimingWatcher && _frameTimeUs != 0) {
+        _frameTimingWatcher->onFrameTiming(getExpectedFrameTimeUs(), getFramePeriodUs(), _phaseOffsetUs);
+    }
+    return true;
+}
+
+/*!
+Records the start time of the latest RC frame and updates the measured frame period.
+
+Intervals of more than 4 frame periods (ie when frames have been lost) are not used in the measurement.
+*/
+void ReceiverCRSF::updateFrameTiming()
+{
+    enum { MAX_FRAME_PERIOD_US = 100000 };
+    const uint32_t framePeriodUs = _packetStartTime - _frameTimeUs;
+    if (_measuredFramePeriodUs == 0) {
+        if (_frameTimeUs != 0 && framePeriodUs < MAX_FRAME_PERIOD_US) {
+            _measuredFramePeriodUs = framePeriodUs;
+        }
+    } else if (framePeriodUs < 4*_measuredFramePeriodUs) {
+        // exponential moving average, with smoothing factor of 1/8
+        _measuredFramePeriodUs = static_cast<uint32_t>(static_cast<int32_t>(_measuredFramePeriodUs) + (static_cast<int32_t>(framePeriodUs) - static_cast<int32_t>(_measuredFramePeriodUs)) / 8);
+    }
+    _frameTimeUs = _packetStartTime;
+    if (_frameTimingWatcher && getFramePeriodUs() != 0) {
+        _frameTimingWatcher->onFrameTiming(getExpectedFrameTimeUs(), getFramePeriodUs(), _phaseOffsetUs);
+    }
+}
+
 /*!
 If the packet is valid then unpack it into the member data and set the packet to empty.
 
@@ -115,6 +175,7 @@ Returns true if a valid packet received, false otherwise.
 bool ReceiverCRSF::unpackPacket()
 {
     if (calculateCRC() != getReceivedCRC()) {
+        onCrcError();
         _packetIsEmpty = true;
         return false;
     }
@@ -161,10 +222,19 @@ bool ReceiverCRSF::unpackPacket()
         _channels[14] = rcChannels->chan14;
         _channels[15] = rcChannels->chan15;
 #endif
+        updateFrameTiming();
         _packetIsEmpty = false;
         return true;
     }
 
+    if (_packet.value.type == FRAMETYPE_RADIO_ID) {
+        processSyncFrame();
+    }
+
+    if (_packet.value.type == FRAMETYPE_DEVICE_PING || _packet.value.type == FRAMETYPE_PARAMETER_READ || _packet.value.type == FRAMETYPE_PARAMETER_WRITE) {
+        processExtendedFrame();
+    }
+
     _packetIsEmpty = true;
     return false;
 }
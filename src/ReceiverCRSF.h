@@ -2,6 +2,18 @@
 
 #include "ReceiverSerial.h"
 
+class CRSF_ParameterServer;
+
+
+/*!
+Interface to allow a scheduler to align its loop with the arrival of RC frames.
+*/
+class ReceiverFrameTimingWatcher {
+public:
+    virtual ~ReceiverFrameTimingWatcher() = default;
+    virtual void onFrameTiming(timeUs32_t expectedFrameTimeUs, uint32_t framePeriodUs, int32_t phaseOffsetUs) = 0;
+};
+
 
 /*!
 CRSF receiver protocol'
@@ -35,6 +47,7 @@ public:
         FRAMETYPE_PARAMETER_READ = 0x2C,
         FRAMETYPE_PARAMETER_WRITE = 0x2D,
         FRAMETYPE_COMMAND = 0x32,
+        FRAMETYPE_RADIO_ID = 0x3A,
         // MSP commands
         FRAMETYPE_MSP_REQ = 0x7A,
         FRAMETYPE_MSP_RESP = 0x7B,
@@ -64,6 +77,8 @@ public:
         COMMAND_SUBCMD_GENERAL_CRSF_SPEED_PROPOSAL = 0x70,
         COMMAND_SUBCMD_GENERAL_CRSF_SPEED_RESPONSE = 0x71,
     };
+    enum { RADIO_ID_SUBTYPE_OPENTX_SYNC = 0x10 };
+    enum { OPENTX_SYNC_PAYLOAD_SIZE = 11 }; // destination, origin, subtype, 4-byte rate, and 4-byte offset
 
     enum { MAX_PACKET_SIZE = 64 };
     union packet_u {
@@ -113,15 +128,37 @@ public:
     static uint8_t calculateCRC(uint8_t crc, uint8_t value);
     uint8_t calculateCRC() const;
     uint8_t getReceivedCRC() const;
+    void setParameterServer(CRSF_ParameterServer* parameterServer) { _parameterServer = parameterServer; }
+    CRSF_ParameterServer* getParameterServer() const { return _parameterServer; }
+    void setFrameTimingWatcher(ReceiverFrameTimingWatcher* frameTimingWatcher) { _frameTimingWatcher = frameTimingWatcher; }
+    //! Frame period from OpenTX sync frames if they have been received, otherwise measured from the arrival of RC frames.
+    uint32_t getFramePeriodUs() const { return _syncFramePeriodUs != 0 ? _syncFramePeriodUs : _measuredFramePeriodUs; }
+    uint32_t getMeasuredFramePeriodUs() const { return _measuredFramePeriodUs; }
+    int32_t getPhaseOffsetUs() const { return _phaseOffsetUs; }
+    bool isSyncReceived() const { return _syncFramePeriodUs != 0; }
+    timeUs32_t getFrameTimeUs() const { return _frameTimeUs; } //!< start time of the most recent RC frame
+    timeUs32_t getExpectedFrameTimeUs() const { return _frameTimeUs + getFramePeriodUs(); } //!< expected start time of the next RC frame
 // for debug
     uint8_t getPacketSync() const { return _packet.value.sync; }
     uint8_t getPacketLength() const { return _packet.value.length; }
     uint8_t getPacketType() const { return _packet.value.type; }
+private:
+    bool processExtendedFrame();
+    bool processSyncFrame();
+    void updateFrameTiming();
 private:
     enum { MAX_PAYLOAD_SIZE = MAX_PACKET_SIZE - 6 };
+    CRSF_ParameterServer* _parameterServer {nullptr};
+    ReceiverFrameTimingWatcher* _frameTimingWatcher {nullptr};
+    timeUs32_t _packetStartTime {}; //!< start time of _packet, set in ISR
+    timeUs32_t _frameTimeUs {};
+    uint32_t _measuredFramePeriodUs {};
+    uint32_t _syncFramePeriodUs {};
+    int32_t _phaseOffsetUs {};
     uint32_t _packetSize {};
     uint32_t _packetType {};
     packet_u _packetISR {};
     packet_u _packet {};
+    std::array<uint8_t, MAX_PACKET_SIZE> _response {};
     std::array<uint16_t, CHANNEL_COUNT> _channels {};
 };
@@ -0,0 +1,146 @@
+#include "ReceiverDSM.h"
+
+
+ReceiverDSM::ReceiverDSM(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverDSM::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(getChannelPWM(THROTTLE)) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(getChannelPWM(ROLL)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(getChannelPWM(PITCH)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(getChannelPWM(YAW)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+/*!
+Channels are stored as 11-bit values, which map to PWM as 988 + value/2, so 1024 maps to 1500us.
+*/
+uint16_t ReceiverDSM::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return static_cast<uint16_t>(988U + (_channels[index] >> 1U)); // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+
+There is no sync byte, so a byte that arrives after the frame gap starts a new frame.
+*/
+bool ReceiverDSM::onDataReceivedFromISR(uint8_t data)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        onFrameTimeout();
+    }
+
+    if (_packetIndex == 0) {
+        _startTime = timeNowUs;
+    }
+
+    _packetISR[_packetIndex++] = data;
+
+    if (_packetIndex == FRAME_SIZE) {
+        _packetIndex = 0;
+        _packet = _packetISR;
+        _packetIsEmpty = false;
+        onFrameComplete();
+        return true;
+    }
+    return false;
+}
+
+/*!
+Spektrum transmitters send a contiguous set of channels starting at channel 0, at least 6 channels.
+*/
+bool ReceiverDSM::isValidChannelMask(uint16_t mask)
+{
+    enum { MIN_CHANNEL_COUNT = 6 };
+    const uint32_t maskPlusOne = static_cast<uint32_t>(mask) + 1;
+    return (mask & ((1U << MIN_CHANNEL_COUNT) - 1)) == ((1U << MIN_CHANNEL_COUNT) - 1) // has at least the minimum channels
+        && (maskPlusOne & mask) == 0 // is contiguous
+        && maskPlusOne <= (1U << CHANNEL_COUNT);
+}
+
+/*!
+Accumulates the channel IDs given by both the 10-bit and 11-bit interpretations of the channel words over several frames.
+The interpretation that gives a valid channel mask is used. If both are valid, then the system byte decides.
+*/
+void ReceiverDSM::detectResolution()
+{
+    for (size_t ii = 0; ii < CHANNEL_WORD_COUNT; ++ii) {
+        const auto word = static_cast<uint16_t>((_packet[2 + 2*ii] << 8U) | _packet[3 + 2*ii]);
+        if (word == UNUSED_CHANNEL_WORD) {
+            continue;
+        }
+        _detectionMask10 |= static_cast<uint16_t>(1U << ((word >> 10U) & 0x0FU));
+        _detectionMask11 |= static_cast<uint16_t>(1U << ((word >> 11U) & 0x0FU));
+    }
+    ++_detectionFrameCount;
+    if (_detectionFrameCount < DETECTION_FRAME_COUNT) {
+        return;
+    }
+
+    const bool valid10 = isValidChannelMask(_detectionMask10);
+    const bool valid11 = isValidChannelMask(_detectionMask11);
+    if (valid10 && (!valid11 || _system == SYSTEM_DSM2_1024_22MS)) {
+        _resolution = RESOLUTION_10_BIT;
+        _channelMask = _detectionMask10;
+    } else if (valid11) {
+        _resolution = RESOLUTION_11_BIT;
+        _channelMask = _detectionMask11;
+    }
+    // if neither is valid, start again
+    _detectionMask10 = 0;
+    _detectionMask11 = 0;
+    _detectionFrameCount = 0;
+}
+
+/*!
+Unpack the frame into the member data and set the packet to empty.
+
+Returns true when a complete channel set has been received, false otherwise.
+*/
+bool ReceiverDSM::unpackPacket()
+{
+    _packetIsEmpty = true;
+    _fadeCount = _packet[0];
+    _system = _packet[1];
+
+    if (_resolution == RESOLUTION_UNKNOWN) {
+        detectResolution();
+        return false;
+    }
+
+    // Spektrum uses TAER (Throttle, Ailerons, Elevator, Rudder), so map onto AETR
+    static constexpr std::array<uint8_t, STICK_COUNT> TAER_TO_AETR = { THROTTLE, ROLL, PITCH, YAW };
+
+    const bool is11Bit = (_resolution == RESOLUTION_11_BIT);
+    for (size_t ii = 0; ii < CHANNEL_WORD_COUNT; ++ii) {
+        const auto word = static_cast<uint16_t>((_packet[2 + 2*ii] << 8U) | _packet[3 + 2*ii]);
+        if (word == UNUSED_CHANNEL_WORD) {
+            continue;
+        }
+        const uint32_t id = is11Bit ? (word >> 11U) & 0x0FU : (word >> 10U) & 0x0FU;
+        if (id >= CHANNEL_COUNT) {
+            continue;
+        }
+        const auto value = static_cast<uint16_t>(is11Bit ? word & 0x07FFU : (word & 0x03FFU) << 1U);
+        _channels[id < STICK_COUNT ? TAER_TO_AETR[id] : id] = value;
+        _receivedChannelMask |= static_cast<uint16_t>(1U << id);
+    }
+
+    if ((_receivedChannelMask & _channelMask) != _channelMask) {
+        // first frame of a two-frame channel set
+        return false;
+    }
+    _receivedChannelMask = 0;
+    return true;
+}
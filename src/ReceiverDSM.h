@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+Spektrum DSM2/DSMX satellite receiver protocol.
+
+Frames are 16 bytes
+    1 fade count byte
+    1 system byte
+    7 big-endian 16-bit channel words, 0xFFFF for an unused word
+
+There is no CRC and no sync byte, so frames are delimited by the gap between frames.
+
+In 10-bit (1024) mode a channel word has a 4-bit channel ID in bits 13..10 and the value in bits 9..0.
+In 11-bit (2048) mode a channel word has a phase bit in bit 15, a 4-bit channel ID in bits 14..11 and the value in bits 10..0.
+The resolution is detected from the pattern of channel IDs: only one of the two interpretations gives a contiguous set of channels.
+
+When there are more channels than fit in a frame, they are sent over two frames. A channel set is complete when all channels have been received.
+*/
+class ReceiverDSM : public ReceiverSerial {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 12;
+    enum { BAUD_RATE = 115200 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1
+    enum { TIME_NEEDED_PER_FRAME_US = 5000 }; // frame takes 1.4ms at 115200 baud, frames are 11ms or 22ms apart
+
+    enum { FRAME_SIZE = 16, CHANNEL_WORD_COUNT = 7 };
+    enum { UNUSED_CHANNEL_WORD = 0xFFFF };
+    enum { SYSTEM_DSM2_1024_22MS = 0x01, SYSTEM_DSM2_2048_11MS = 0x12, SYSTEM_DSMX_2048_22MS = 0xA2, SYSTEM_DSMX_2048_11MS = 0xB2 };
+    enum resolution_e { RESOLUTION_UNKNOWN, RESOLUTION_10_BIT, RESOLUTION_11_BIT };
+    enum { DETECTION_FRAME_COUNT = 5 };
+public:
+    explicit ReceiverDSM(SerialPort& serialPort);
+private:
+    // ReceiverDSM is not copyable or moveable
+    ReceiverDSM(const ReceiverDSM&) = delete;
+    ReceiverDSM& operator=(const ReceiverDSM&) = delete;
+    ReceiverDSM(ReceiverDSM&&) = delete;
+    ReceiverDSM& operator=(ReceiverDSM&&) = delete;
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    resolution_e getResolution() const { return _resolution; }
+    uint16_t getChannelMask() const { return _channelMask; } //!< channels sent by the satellite, valid once resolution detected
+    uint8_t getFadeCount() const { return _fadeCount; }
+    uint8_t getSystem() const { return _system; }
+private:
+    void detectResolution();
+    static bool isValidChannelMask(uint16_t mask);
+private:
+    std::array<uint8_t, FRAME_SIZE> _packetISR {};
+    std::array<uint8_t, FRAME_SIZE> _packet {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {}; //!< 11-bit channel values, in AETR order
+    resolution_e _resolution {RESOLUTION_UNKNOWN};
+    uint16_t _channelMask {};
+    uint16_t _receivedChannelMask {};
+    // resolution detection
+    uint16_t _detectionMask10 {};
+    uint16_t _detectionMask11 {};
+    uint8_t _detectionFrameCount {};
+    uint8_t _fadeCount {};
+    uint8_t _system {};
+};
@@ -0,0 +1,240 @@
+#include "ReceiverDiversity.h"
+
+
+ReceiverDiversity::ReceiverDiversity(ReceiverBase& primary, ReceiverBase& secondary)
+{
+    addReceiver(primary);
+    addReceiver(secondary);
+}
+
+/*!
+Adds a source receiver. Sources added first are preferred when sources are of equal quality.
+
+Returns false if there are already MAX_SOURCE_COUNT sources.
+*/
+bool ReceiverDiversity::addReceiver(ReceiverBase& receiver)
+{
+    if (_sourceCount >= MAX_SOURCE_COUNT) {
+        return false;
+    }
+    _sources[_sourceCount] = source_t {
+        .receiver = &receiver,
+        .lastFrameTimeUs = 0,
+        .framePeriodUs = DEFAULT_FRAME_PERIOD_US,
+        .linkQualityQ8 = 0,
+        .frameCount = 0
+    };
+    ++_sourceCount;
+    return true;
+}
+
+/*!
+Waits for data on any of the sources, polling each in turn.
+
+Returns 1 if any source received data, 0 on timeout.
+*/
+int32_t ReceiverDiversity::WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait)
+{
+    if (_sourceCount == 0) {
+        return 0;
+    }
+    const size_t first = _activeSource == NO_SOURCE ? 0 : _activeSource;
+    uint32_t ticksWaited = 0;
+    do {
+        // wait one tick on the active source, and just check the others
+        if (_sources[first].receiver->WAIT_FOR_DATA_RECEIVED(ticksToWait == 0 ? 0 : 1) != 0) {
+            return 1;
+        }
+        for (size_t ii = 0; ii < _sourceCount; ++ii) {
+            if (ii != first && _sources[ii].receiver->WAIT_FOR_DATA_RECEIVED(0) != 0) {
+                return 1;
+            }
+        }
+        ++ticksWaited;
+    } while (ticksWaited < ticksToWait);
+    return 0;
+}
+
+bool ReceiverDiversity::isSourceHealthy(size_t index, timeUs32_t timeNowUs) const
+{
+    if (index >= _sourceCount) {
+        return false;
+    }
+    const source_t& source = _sources[index];
+    if (source.frameCount == 0) {
+        return false;
+    }
+    return timeNowUs - source.lastFrameTimeUs <= source.framePeriodUs + source.framePeriodUs / 2;
+}
+
+/*!
+Called when the source has received a valid frame. Updates its frame period estimate and link quality.
+Frames missed since the previous frame are counted as failures when updating the link quality.
+*/
+void ReceiverDiversity::updateSourceStatistics(source_t& source, timeUs32_t timeNowUs)
+{
+    enum { LINK_QUALITY_MAX_Q8 = 100U << 8U, LINK_QUALITY_FILTER_SHIFT = 3, FRAME_PERIOD_FILTER_SHIFT = 2, MAX_COUNTED_MISSED_FRAMES = 32 };
+
+    if (source.frameCount > 0) {
+        const uint32_t intervalUs = timeNowUs - source.lastFrameTimeUs;
+        uint32_t missedFrames = 0;
+        if (intervalUs > source.framePeriodUs + source.framePeriodUs / 2) {
+            missedFrames = (intervalUs + source.framePeriodUs / 2) / source.framePeriodUs - 1;
+            if (missedFrames > MAX_COUNTED_MISSED_FRAMES) {
+                missedFrames = MAX_COUNTED_MISSED_FRAMES;
+            }
+        } else if (intervalUs >= MIN_FRAME_PERIOD_US) {
+            // only intervals without missed frames are used to estimate the frame period
+            if (source.frameCount == 1) {
+                source.framePeriodUs = intervalUs;
+            } else {
+                source.framePeriodUs = static_cast<uint32_t>(static_cast<int32_t>(source.framePeriodUs) + ((static_cast<int32_t>(intervalUs) - static_cast<int32_t>(source.framePeriodUs)) >> FRAME_PERIOD_FILTER_SHIFT));
+            }
+            if (source.framePeriodUs > MAX_FRAME_PERIOD_US) {
+                source.framePeriodUs = MAX_FRAME_PERIOD_US;
+            }
+        }
+        for (uint32_t ii = 0; ii < missedFrames; ++ii) {
+            source.linkQualityQ8 -= source.linkQualityQ8 >> LINK_QUALITY_FILTER_SHIFT;
+        }
+    }
+    source.linkQualityQ8 += (LINK_QUALITY_MAX_Q8 - source.linkQualityQ8) >> LINK_QUALITY_FILTER_SHIFT;
+    source.lastFrameTimeUs = timeNowUs;
+    ++source.frameCount;
+}
+
+/*!
+Returns the index of the source that should be active.
+*/
+size_t ReceiverDiversity::selectSource(timeUs32_t timeNowUs) const
+{
+    if (_activeSource != NO_SOURCE && isSourceHealthy(_activeSource, timeNowUs)) {
+        // only change to a source that has a significantly better link quality
+        size_t best = _activeSource;
+        uint32_t bestLinkQualityQ8 = _sources[_activeSource].linkQualityQ8 + (LINK_QUALITY_HYSTERESIS_PERCENT << 8U);
+        for (size_t ii = 0; ii < _sourceCount; ++ii) {
+            if (ii != _activeSource && isSourceHealthy(ii, timeNowUs) && _sources[ii].linkQualityQ8 > bestLinkQualityQ8) {
+                best = ii;
+                bestLinkQualityQ8 = _sources[ii].linkQualityQ8;
+            }
+        }
+        return best;
+    }
+    // active source is not healthy, so fail over to the healthy source with the freshest frame
+    size_t freshest = _activeSource;
+    uint32_t freshestAgeUs = UINT32_MAX;
+    for (size_t ii = 0; ii < _sourceCount; ++ii) {
+        if (isSourceHealthy(ii, timeNowUs)) {
+            const uint32_t ageUs = timeNowUs - _sources[ii].lastFrameTimeUs;
+            if (ageUs < freshestAgeUs) {
+                freshest = ii;
+                freshestAgeUs = ageUs;
+            }
+        }
+    }
+    return freshest;
+}
+
+bool ReceiverDiversity::update(uint32_t tickCountDelta)
+{
+    return update(tickCountDelta, timeUs());
+}
+
+/*!
+Updates all the sources and takes the frame from the active source.
+
+Returns true if there is a new frame from the active source, or if the active source has changed.
+*/
+bool ReceiverDiversity::update(uint32_t tickCountDelta, timeUs32_t timeNowUs)
+{
+    uint32_t newFrameMask = 0;
+    for (size_t ii = 0; ii < _sourceCount; ++ii) {
+        ReceiverBase& receiver = *_sources[ii].receiver;
+        // for time based scheduling each source must be given the data from its own serial port
+        while (receiver.isDataAvailable()) {
+            if (receiver.onDataReceivedFromISR(receiver.readByte())) {
+                break;
+            }
+        }
+        if (receiver.update(tickCountDelta)) {
+            updateSourceStatistics(_sources[ii], timeNowUs);
+            newFrameMask |= 1U << ii;
+        }
+    }
+
+    const size_t selected = selectSource(timeNowUs);
+    if (selected == NO_SOURCE) {
+        return false;
+    }
+    const bool sourceChanged = selected != _activeSource;
+    if (sourceChanged) {
+        _activeSource = selected;
+        ++_sourceSwitchCount;
+    } else if ((newFrameMask & (1U << selected)) == 0) {
+        return false;
+    }
+
+    const ReceiverBase& active = *_sources[_activeSource].receiver;
+    _controls = active.getControls();
+    _switches = active.getSwitches();
+    _auxiliaryChannelCount = active.getAuxiliaryChannelCount();
+
+    _packetReceived = true;
+    ++_packetCount;
+    _tickCountDelta = tickCountDelta;
+    // frames missed by the active source are counted as dropped
+    _droppedPacketCountDelta = sourceChanged ? 0 : active.getDroppedPacketCountDelta();
+    _droppedPacketCount += _droppedPacketCountDelta;
+    _droppedPacketCountPrevious = _droppedPacketCount;
+
+    _newPacketAvailable = true;
+    return true;
+}
+
+/*!
+The sources' packets are unpacked by their own update() functions.
+*/
+bool ReceiverDiversity::unpackPacket()
+{
+    return true;
+}
+
+void ReceiverDiversity::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    if (_activeSource == NO_SOURCE) {
+        throttleStick = 0.0F;
+        rollStick = 0.0F;
+        pitchStick = 0.0F;
+        yawStick = 0.0F;
+        return;
+    }
+    _sources[_activeSource].receiver->getStickValues(throttleStick, rollStick, pitchStick, yawStick);
+}
+
+uint16_t ReceiverDiversity::getChannelPWM(size_t index) const
+{
+    if (_activeSource == NO_SOURCE) {
+        return CHANNEL_LOW;
+    }
+    return _sources[_activeSource].receiver->getChannelPWM(index);
+}
+
+/*!
+Returns the sum of the sources' error statistics.
+*/
+ReceiverBase::error_statistics_t ReceiverDiversity::getErrorStatistics() const
+{
+    error_statistics_t errorStatistics {};
+    for (size_t ii = 0; ii < _sourceCount; ++ii) {
+        const error_statistics_t sourceErrorStatistics = _sources[ii].receiver->getErrorStatistics();
+        errorStatistics.uartOverrunCount += sourceErrorStatistics.uartOverrunCount;
+        errorStatistics.uartFramingErrorCount += sourceErrorStatistics.uartFramingErrorCount;
+        errorStatistics.uartParityErrorCount += sourceErrorStatistics.uartParityErrorCount;
+        errorStatistics.crcErrorCount += sourceErrorStatistics.crcErrorCount;
+        errorStatistics.badSyncByteCount += sourceErrorStatistics.badSyncByteCount;
+        errorStatistics.truncatedFrameCount += sourceErrorStatistics.truncatedFrameCount;
+        errorStatistics.resyncCount += sourceErrorStatistics.resyncCount;
+        errorStatistics.discardedByteCount += sourceErrorStatistics.discardedByteCount;
+    }
+    return errorStatistics;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ReceiverBase.h"
+
+#include <TimeMicroseconds.h>
+#include <array>
+
+
+/*!
+Diversity receiver: wraps several receivers, typically on separate UARTs, and presents them as a single receiver.
+
+On each update every source receiver is updated, and the frame from the active source is used.
+If the active source misses a frame, so that its newest frame is older than 1.5 frame periods,
+then the healthy source with the freshest frame becomes active. So failover happens within one frame period, rather than after the failsafe timeout.
+While the active source is healthy, the active source only changes if another healthy source has a link quality
+better by at least LINK_QUALITY_HYSTERESIS_PERCENT, so that the active source does not flip-flop between sources of similar quality.
+
+Link quality is estimated per source from the frames it receives, so it is available for any receiver protocol.
+
+For event driven scheduling WAIT_FOR_DATA_RECEIVED() polls the sources in turn, one tick at a time. Time based scheduling is preferred.
+*/
+class ReceiverDiversity : public ReceiverBase {
+public:
+    enum { MAX_SOURCE_COUNT = 4 };
+    enum { NO_SOURCE = 0xFF };
+    enum { LINK_QUALITY_HYSTERESIS_PERCENT = 10 };
+    enum { DEFAULT_FRAME_PERIOD_US = 20000, MIN_FRAME_PERIOD_US = 1000, MAX_FRAME_PERIOD_US = 100000 };
+    struct source_t {
+        ReceiverBase* receiver;
+        timeUs32_t lastFrameTimeUs;
+        uint32_t framePeriodUs; //!< estimated from the interval between frames
+        uint32_t linkQualityQ8; //!< link quality as percent, in Q24.8 fixed point
+        uint32_t frameCount;
+    };
+public:
+    ReceiverDiversity() = default;
+    ReceiverDiversity(ReceiverBase& primary, ReceiverBase& secondary);
+private:
+    // ReceiverDiversity is not copyable or moveable
+    ReceiverDiversity(const ReceiverDiversity&) = delete;
+    ReceiverDiversity& operator=(const ReceiverDiversity&) = delete;
+    ReceiverDiversity(ReceiverDiversity&&) = delete;
+    ReceiverDiversity& operator=(ReceiverDiversity&&) = delete;
+public:
+    bool addReceiver(ReceiverBase& receiver);
+    virtual int32_t WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) override;
+    virtual bool update(uint32_t tickCountDelta) override;
+    bool update(uint32_t tickCountDelta, timeUs32_t timeNowUs);
+    virtual bool unpackPacket() override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual error_statistics_t getErrorStatistics() const override;
+
+    size_t getSourceCount() const { return _sourceCount; }
+    size_t getActiveSource() const { return _activeSource; } //!< index of the active source, in the order added, or NO_SOURCE if no source has received a frame
+    uint32_t getSourceSwitchCount() const { return _sourceSwitchCount; }
+    uint32_t getLinkQuality(size_t index) const { return index < _sourceCount ? _sources[index].linkQualityQ8 >> 8U : 0; } //!< link quality, percent
+    uint32_t getFramePeriodUs(size_t index) const { return index < _sourceCount ? _sources[index].framePeriodUs : 0; }
+    bool isSourceHealthy(size_t index, timeUs32_t timeNowUs) const;
+private:
+    void updateSourceStatistics(source_t& source, timeUs32_t timeNowUs);
+    size_t selectSource(timeUs32_t timeNowUs) const;
+private:
+    std::array<source_t, MAX_SOURCE_COUNT> _sources {};
+    size_t _sourceCount {};
+    size_t _activeSource {NO_SOURCE};
+    uint32_t _sourceSwitchCount {};
+};
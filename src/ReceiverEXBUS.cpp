@@ -0,0 +1,173 @@
+#include "ReceiverCRC.h"
+#include "ReceiverEXBUS.h"
+
+#include <algorithm>
+
+
+ReceiverEXBUS::ReceiverEXBUS(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverEXBUS::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(getChannelPWM(THROTTLE)) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(getChannelPWM(ROLL)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(getChannelPWM(PITCH)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(getChannelPWM(YAW)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+uint16_t ReceiverEXBUS::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return static_cast<uint16_t>(_channels[index] >> 3U);
+}
+
+uint16_t ReceiverEXBUS::calculateCRC(const uint8_t* data, size_t length)
+{
+    return crc16_CCITT_Reflected(0, data, length);
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+*/
+bool ReceiverEXBUS::onDataReceivedFromISR(uint8_t data)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        onFrameTimeout();
+    }
+
+    if (_packetIndex == 0) {
+        if (data != HEADER_NO_REPLY && data != HEADER_REQUEST) {
+            onBadSyncByte();
+            return false;
+        }
+        _startTime = timeNowUs;
+    } else if (_packetIndex == 1) {
+        if (data != HEADER2_CHANNEL_DATA && data != HEADER2_REQUEST) {
+            onBadSyncByte();
+            return false;
+        }
+    } else if (_packetIndex == 2) {
+        if (data < MIN_PACKET_SIZE || data > MAX_PACKET_SIZE) {
+            onBadSyncByte();
+            return false;
+        }
+        _packetSize = data;
+    }
+
+    _packetISR[_packetIndex++] = data;
+
+    if (_packetIndex > 2 && _packetIndex == _packetSize) {
+        _packetIndex = 0;
+        _packet = _packetISR;
+        _packetEndTimeUs = timeNowUs;
+        _packetIsEmpty = false;
+        onFrameComplete();
+        return true;
+    }
+    return false;
+}
+
+/*!
+Sets the EX telemetry data sent in reply to telemetry requests.
+
+The reply is formatted here, into the buffer not currently in use, so that replying to a request is just filling in the packet ID and CRC.
+
+Returns false if the data is too large.
+*/
+bool ReceiverEXBUS::setTelemetryData(const uint8_t* data, size_t length)
+{
+    if (length > MAX_TELEMETRY_DATA_SIZE) {
+        return false;
+    }
+    const uint8_t nextIndex = _responseIndex ^ 1U;
+    response_t& response = _responses[nextIndex];
+    response.data[0] = HEADER_REPLY;
+    response.data[1] = HEADER2_REQUEST;
+    response.data[2] = static_cast<uint8_t>(HEADER_SIZE + length + CRC_SIZE);
+    response.data[3] = 0; // packet ID, filled in when replying
+    response.data[4] = DATA_ID_TELEMETRY;
+    response.data[5] = static_cast<uint8_t>(length);
+    std::copy(data, data + length, &response.data[HEADER_SIZE]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    response.length = HEADER_SIZE + length + CRC_SIZE;
+    _responseIndex = nextIndex;
+    return true;
+}
+
+/*!
+Replies to a telemetry request, echoing the request's packet ID.
+*/
+void ReceiverEXBUS::sendTelemetry()
+{
+    // copy the reply before filling it in, setTelemetryData() may swap the buffers again while the reply is being transmitted
+    const response_t& response = _responses[_responseIndex];
+    if (response.length == 0) {
+        // no telemetry data has been set
+        return;
+    }
+    _txResponse = response;
+    _txResponse.data[3] = _packet[3];
+    const uint16_t crc = calculateCRC(&_txResponse.data[0], _txResponse.length - CRC_SIZE);
+    _txResponse.data[_txResponse.length - 2] = static_cast<uint8_t>(crc);
+    _txResponse.data[_txResponse.length - 1] = static_cast<uint8_t>(crc >> 8U);
+    _serialPort.write(&_txResponse.data[0], _txResponse.length);
+    ++_responseCount;
+}
+
+void ReceiverEXBUS::unpackChannels()
+{
+    const size_t dataLength = _packet[5];
+    const size_t channelCount = std::min(dataLength / 2, static_cast<size_t>(CHANNEL_COUNT));
+    for (size_t ii = 0; ii < channelCount; ++ii) {
+        _channels[ii] = static_cast<uint16_t>(_packet[HEADER_SIZE + 2*ii] | (_packet[HEADER_SIZE + 2*ii + 1] << 8U));
+    }
+}
+
+/*!
+If the packet is valid then handle it and set the packet to empty.
+
+Returns true if a valid channel data packet received, false otherwise.
+*/
+bool ReceiverEXBUS::unpackPacket()
+{
+    _packetIsEmpty = true;
+
+    const size_t length = _packet[2];
+    const uint16_t receivedCRC = static_cast<uint16_t>(_packet[length - 2] | (_packet[length - 1] << 8U));
+    if (calculateCRC(&_packet[0], length - CRC_SIZE) != receivedCRC) {
+        onCrcError();
+        return false;
+    }
+    if (_packet[5] > length - MIN_PACKET_SIZE) {
+        // data length is longer than the packet, so the data is truncated
+        ++_errorStatistics.truncatedFrameCount;
+        return false;
+    }
+
+    switch (_packet[4]) {
+    case DATA_ID_CHANNEL:
+        // EX Bus uses AETR (Ailerons, Elevator, Throttle, Rudder), ie ROLL, PITCH, THROTTLE, YAW, if so set in the transmitter
+        unpackChannels();
+        return true;
+    case DATA_ID_TELEMETRY:
+        if (_packet[0] == HEADER_REQUEST) {
+            if (timeUs() - _packetEndTimeUs > MAX_RESPONSE_DELAY_US) {
+                // too late to reply
+                ++_lateRequestCount;
+            } else {
+                sendTelemetry();
+            }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+Jeti EX Bus receiver protocol.
+
+EX Bus is a half-duplex protocol, the receiver is the bus master and polls devices for telemetry.
+
+Packets are
+    1 header byte (0x3E for packets that need no reply, 0x3D for requests)
+    1 second header byte (0x01 or 0x03)
+    1 length byte, the length of the whole packet including the CRC
+    1 packet ID, which the reply must echo
+    1 data identifier byte (0x31 for channel data, 0x3A for telemetry, 0x3B for JetiBox)
+    1 data length byte
+    data
+    2 CRC bytes, reflected CRC16-CCITT over all the preceding bytes, least significant byte first
+
+Channel data is 2 bytes per channel, little-endian in units of 1/8 microsecond.
+*/
+class ReceiverEXBUS : public ReceiverSerial {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 16;
+    enum { BAUD_RATE = 125000, BAUD_RATE_FAST = 250000 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1
+    enum { TIME_NEEDED_PER_FRAME_US = 6000 }; // maximum size packet at 125000 baud, with margin
+    enum { MAX_RESPONSE_DELAY_US = 4000 }; // the receiver resumes transmitting after this, so a later reply would collide
+
+    enum { HEADER_NO_REPLY = 0x3E, HEADER_REQUEST = 0x3D, HEADER_REPLY = 0x3B };
+    enum { HEADER2_CHANNEL_DATA = 0x03, HEADER2_REQUEST = 0x01 };
+    enum { DATA_ID_CHANNEL = 0x31, DATA_ID_TELEMETRY = 0x3A, DATA_ID_JETIBOX = 0x3B };
+    enum {
+        HEADER_SIZE = 6,
+        CRC_SIZE = 2,
+        MAX_PACKET_SIZE = 64,
+        MIN_PACKET_SIZE = HEADER_SIZE + CRC_SIZE,
+        MAX_TELEMETRY_DATA_SIZE = MAX_PACKET_SIZE - HEADER_SIZE - CRC_SIZE
+    };
+    struct response_t {
+        std::array<uint8_t, MAX_PACKET_SIZE> data;
+        size_t length;
+    };
+public:
+    explicit ReceiverEXBUS(SerialPort& serialPort);
+private:
+    // ReceiverEXBUS is not copyable or moveable
+    ReceiverEXBUS(const ReceiverEXBUS&) = delete;
+    ReceiverEXBUS& operator=(const ReceiverEXBUS&) = delete;
+    ReceiverEXBUS(ReceiverEXBUS&&) = delete;
+    ReceiverEXBUS& operator=(ReceiverEXBUS&&) = delete;
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    static uint16_t calculateCRC(const uint8_t* data, size_t length);
+    bool setTelemetryData(const uint8_t* data, size_t length);
+// for testing
+    const response_t& getResponse() const { return _txResponse; } //!< the most recently sent reply
+    uint32_t getResponseCount() const { return _responseCount; }
+    uint32_t getLateRequestCount() const { return _lateRequestCount; }
+private:
+    void unpackChannels();
+    void sendTelemetry();
+private:
+    std::array<uint8_t, MAX_PACKET_SIZE> _packetISR {};
+    std::array<uint8_t, MAX_PACKET_SIZE> _packet {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {}; //!< channel values in units of 1/8 microsecond
+    size_t _packetSize {};
+    timeUs32_t _packetEndTimeUs {}; //!< time _packet was completed, set in ISR
+    // double buffered preformatted telemetry replies, only the packet ID and the CRC are filled in when replying
+    std::array<response_t, 2> _responses {};
+    volatile uint8_t _responseIndex {};
+    response_t _txResponse {}; //!< copy of the reply being sent, so setTelemetryData() cannot overwrite it while it is being transmitted
+    uint32_t _responseCount {};
+    uint32_t _lateRequestCount {};
+};
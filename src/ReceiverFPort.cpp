@@ -0,0 +1,217 @@
+#include "ReceiverFPort.h"
+#include "ReceiverSBUS.h"
+
+
+ReceiverFPort::ReceiverFPort(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+    packResponse(_emptyResponse, SPORT_FRAME_ID_EMPTY, 0, 0);
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverFPort::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(_channels[THROTTLE]) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(_channels[ROLL]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(_channels[PITCH]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(_channels[YAW]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+uint16_t ReceiverFPort::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return _channels[index];
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+
+Removes the byte-stuffing and collects the frame. The frame is complete as soon as its length and CRC bytes have been received,
+so there is no need to wait for the closing FRAME_MARKER.
+*/
+bool ReceiverFPort::onDataReceivedFromISR(uint8_t data)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        onFrameTimeout();
+        _escaped = false;
+    }
+
+    if (data == FRAME_MARKER) {
+        // start of new frame, (any incomplete frame is discarded)
+        _packetIndex = 0;
+        _escaped = false;
+        _inFrame = true;
+        _startTime = timeNowUs;
+        return false;
+    }
+    if (!_inFrame) {
+        return false;
+    }
+    if (data == ESCAPE_BYTE) {
+        _escaped = true;
+        return false;
+    }
+    if (_escaped) {
+        _escaped = false;
+        data ^= ESCAPE_XOR;
+    }
+
+    if (_packetIndex == 0 && data != CONTROL_FRAME_LENGTH && data != DOWNLINK_FRAME_LENGTH) {
+        // invalid length, so wait for next frame
+        onBadSyncByte();
+        _inFrame = false;
+        return false;
+    }
+
+    _packetISR[_packetIndex++] = data;
+
+    // frame is length byte, type and payload (length bytes), and CRC
+    if (_packetIndex == static_cast<size_t>(_packetISR[0]) + 2) {
+        _packetIndex = 0;
+        _inFrame = false;
+        _packet = _packetISR;
+        _packetIsEmpty = false;
+        onFrameComplete();
+        return true;
+    }
+    return false;
+}
+
+/*!
+FPort CRC is 0xFF minus the sum of the bytes, with the carry added back in.
+*/
+uint8_t ReceiverFPort::calculateCRC(const uint8_t* data, size_t length)
+{
+    uint32_t sum = 0;
+    for (size_t ii = 0; ii < length; ++ii) {
+        sum += data[ii]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    while (sum > 0xFF) { // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+        sum = (sum & 0xFFU) + (sum >> 8U);
+    }
+    return static_cast<uint8_t>(0xFFU - sum);
+}
+
+/*!
+Packs an uplink S.Port response frame, byte-stuffing as required.
+*/
+void ReceiverFPort::packResponse(response_t& response, uint8_t frameId, uint16_t dataId, uint32_t value)
+{
+    const std::array<uint8_t, RESPONSE_FRAME_LENGTH + 1> frame = {
+        RESPONSE_FRAME_LENGTH,
+        FRAME_TYPE_RESPONSE,
+        frameId,
+        static_cast<uint8_t>(dataId), static_cast<uint8_t>(dataId >> 8U),
+        static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8U), static_cast<uint8_t>(value >> 16U), static_cast<uint8_t>(value >> 24U)
+    };
+    const uint8_t crc = calculateCRC(&frame[0], frame.size());
+
+    size_t pos = 0;
+    auto stuff = [&response, &pos](uint8_t data) {
+        if (data == FRAME_MARKER || data == ESCAPE_BYTE) {
+            response.data[pos++] = ESCAPE_BYTE;
+            data ^= ESCAPE_XOR;
+        }
+        response.data[pos++] = data;
+    };
+    for (const uint8_t data : frame) {
+        stuff(data);
+    }
+    stuff(crc);
+    response.length = pos;
+}
+
+/*!
+Queues an S.Port sensor value to be sent in response to a telemetry poll.
+
+The response frame is precomputed here, so that replying to a poll is just a write.
+
+Returns false if the queue is full.
+*/
+bool ReceiverFPort::queueTelemetry(uint16_t dataId, uint32_t value)
+{
+    const uint32_t head = _telemetryQueueHead;
+    if (head - _telemetryQueueTail >= TELEMETRY_QUEUE_LENGTH) {
+        return false;
+    }
+    packResponse(_telemetryQueue[head & (TELEMETRY_QUEUE_LENGTH - 1)], SPORT_FRAME_ID_DATA, dataId, value);
+    _telemetryQueueHead = head + 1;
+    return true;
+}
+
+/*!
+Replies to a telemetry poll with the next queued response, or with an empty frame if there is nothing queued.
+*/
+void ReceiverFPort::sendTelemetry()
+{
+    const uint32_t tail = _telemetryQueueTail;
+    if (tail != _telemetryQueueHead) {
+        _response = _telemetryQueue[tail & (TELEMETRY_QUEUE_LENGTH - 1)];
+        _telemetryQueueTail = tail + 1;
+    } else {
+        _response = _emptyResponse;
+    }
+    _serialPort.write(&_response.data[0], _response.length);
+}
+
+/*!
+If the packet is valid then unpack it into the member data and set the packet to empty.
+
+Returns true if a valid control packet received, false otherwise.
+
+FPort control frame is
+    1 length byte (has value 0x19)
+    1 type byte (has value 0x00)
+    22 bytes of channel data, in the same layout as SBUS
+    1 flag byte
+    1 RSSI byte
+    1 CRC byte
+
+Telemetry poll (downlink) frames are answered with the next queued telemetry response.
+*/
+bool ReceiverFPort::unpackPacket()
+{
+    const size_t length = _packet[0];
+    if (calculateCRC(&_packet[0], length + 1) != _packet[length + 1]) {
+        onCrcError();
+        _packetIsEmpty = true;
+        return false;
+    }
+
+    const uint8_t type = _packet[1];
+    if (type == FRAME_TYPE_CONTROL && length == CONTROL_FRAME_LENGTH) {
+        // FPort uses AETR (Ailerons, Elevator, Throttle, Rudder), ie ROLL, PITCH, THROTTLE, YAW
+        ReceiverSBUS::unpackChannels(&_channels[0], &_packet[2]);
+        for (size_t ii = 0; ii < CHANNEL_11_BIT_COUNT; ++ii) {
+            _channels[ii] = ReceiverSBUS::channelToPWM(_channels[ii]);
+        }
+        const uint8_t flags = _packet[24];
+        _channels[16] = (flags & FLAG_CHANNEL_16) ? CHANNEL_HIGH : CHANNEL_LOW;
+        _channels[17] = (flags & FLAG_CHANNEL_17) ? CHANNEL_HIGH : CHANNEL_LOW;
+        if (flags & FLAG_LOST_FRAME) {
+            ++_lostFrameCount;
+        }
+        _failsafe = (flags & FLAG_FAILSAFE) ? true : false;
+        _rssi = _packet[25];
+        if (_failsafe) {
+            // channel values are not valid, so let the cockpit failsafe handle it
+            _packetIsEmpty = true;
+            return false;
+        }
+        _packetIsEmpty = false;
+        return true;
+    }
+
+    if (type == FRAME_TYPE_READ && length == DOWNLINK_FRAME_LENGTH) {
+        sendTelemetry();
+    }
+
+    _packetIsEmpty = true;
+    return false;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+FPort receiver protocol, used by FrSky receivers.
+
+FPort combines SBUS channel data and S.Port telemetry on a single inverted half-duplex wire.
+Frames are delimited by FRAME_MARKER bytes, and any FRAME_MARKER or ESCAPE_BYTE within a frame is byte-stuffed.
+*/
+class ReceiverFPort : public ReceiverSerial {
+public:
+     // 16 11-bit channels (includes 4 main stick channels) and 2 flag channels
+    enum { CHANNEL_11_BIT_COUNT = 16 };
+    static constexpr uint32_t CHANNEL_COUNT = 18;
+    enum { BAUD_RATE = 115200 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1, inverted
+    enum { TIME_NEEDED_PER_FRAME_US = 3000 };
+
+    enum { FRAME_MARKER = 0x7E, ESCAPE_BYTE = 0x7D, ESCAPE_XOR = 0x20 };
+    enum frame_type_e { FRAME_TYPE_CONTROL = 0x00, FRAME_TYPE_READ = 0x01, FRAME_TYPE_WRITE = 0x02, FRAME_TYPE_RESPONSE = 0x81 };
+    enum { CONTROL_FRAME_LENGTH = 0x19, DOWNLINK_FRAME_LENGTH = 0x08, RESPONSE_FRAME_LENGTH = 0x08 };
+    enum { SPORT_FRAME_ID_EMPTY = 0x00, SPORT_FRAME_ID_DATA = 0x10 };
+    enum { FLAG_CHANNEL_16 = 0x01, FLAG_CHANNEL_17 = 0x02, FLAG_LOST_FRAME = 0x04, FLAG_FAILSAFE = 0x08 };
+
+    enum { TELEMETRY_QUEUE_LENGTH = 8 }; // must be a power of 2
+    enum { MAX_RESPONSE_SIZE = 2 * (RESPONSE_FRAME_LENGTH + 2) }; // length, type, payload, and CRC, all of which may be byte-stuffed
+    struct response_t {
+        std::array<uint8_t, MAX_RESPONSE_SIZE> data;
+        size_t length;
+    };
+public:
+    explicit ReceiverFPort(SerialPort& serialPort);
+private:
+    // ReceiverFPort is not copyable or moveable
+    ReceiverFPort(const ReceiverFPort&) = delete;
+    ReceiverFPort& operator=(const ReceiverFPort&) = delete;
+    ReceiverFPort(ReceiverFPort&&) = delete;
+    ReceiverFPort& operator=(ReceiverFPort&&) = delete;
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    static uint8_t calculateCRC(const uint8_t* data, size_t length);
+    bool queueTelemetry(uint16_t dataId, uint32_t value);
+    static void packResponse(response_t& response, uint8_t frameId, uint16_t dataId, uint32_t value);
+// for testing
+    uint8_t getRSSI() const { return _rssi; }
+    bool isFailsafe() const { return _failsafe; }
+    uint32_t getLostFrameCount() const { return _lostFrameCount; }
+    const response_t& getResponse() const { return _response; }
+private:
+    void sendTelemetry();
+private:
+    enum { PACKET_SIZE = CONTROL_FRAME_LENGTH + 2 }; // length, type and payload, and CRC
+    std::array<uint8_t, PACKET_SIZE> _packetISR {};
+    std::array<uint8_t, PACKET_SIZE> _packet {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {};
+    uint8_t _escaped {false};
+    uint8_t _inFrame {false};
+    uint8_t _rssi {};
+    uint8_t _failsafe {false};
+    uint32_t _lostFrameCount {};
+    // telemetry responses are precomputed when they are queued, so replying to a telemetry poll is just a write
+    // single producer (queueTelemetry), single consumer (sendTelemetry)
+    std::array<response_t, TELEMETRY_QUEUE_LENGTH> _telemetryQueue {};
+    volatile uint32_t _telemetryQueueHead {};
+    volatile uint32_t _telemetryQueueTail {};
+    response_t _emptyResponse {};
+    response_t _response {};
+};
@@ -0,0 +1,102 @@
+#include "ReceiverFrameQueue.h"
+
+#include <cstring>
+
+
+/*!
+Returns the slot for the next frame, or nullptr if the queue is full and the policy is OVERFLOW_KEEP_ALL.
+*/
+receiver_frame_t* ReceiverFrameQueue::reserve()
+{
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    if (head - tail >= CAPACITY) {
+        if (_overflowPolicy == OVERFLOW_KEEP_ALL) {
+            _overflowCount.store(_overflowCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        // take the oldest frame from the consumer. If this fails, then the consumer has just taken it, so there is now space.
+        // In either case the consumer fails to take the slot that is about to be overwritten, so never uses a partially written frame.
+        if (_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            _overflowCount.store(_overflowCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+    return &_frames[head & (CAPACITY - 1)];
+}
+
+void ReceiverFrameQueue::commit()
+{
+    const uint32_t head = _head.load(std::memory_order_relaxed) + 1;
+    _head.store(head, std::memory_order_release);
+    _pushCount.store(_pushCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    const uint32_t size = head - _tail.load(std::memory_order_relaxed);
+    if (size > _maxSize.load(std::memory_order_relaxed)) {
+        _maxSize.store(size, std::memory_order_relaxed);
+    }
+}
+
+/*!
+Pushes a copy of the frame. Returns false if the frame was discarded because the queue was full.
+*/
+bool ReceiverFrameQueue::push(const receiver_frame_t& frame)
+{
+    receiver_frame_t* slot = reserve();
+    if (slot == nullptr) {
+        return false;
+    }
+    memcpy(slot, &frame, sizeof(receiver_frame_t));
+    commit();
+    return true;
+}
+
+/*!
+Pushes the controls and a snapshot of the receiver, building the frame in place in the queue.
+The snapshot sequence number is the queue's push count.
+*/
+bool ReceiverFrameQueue::push(const CockpitBase::controls_t& controls, const ReceiverBase& receiver, uint32_t timeUs)
+{
+    receiver_frame_t* slot = reserve();
+    if (slot == nullptr) {
+        return false;
+    }
+    slot->controls = controls;
+    makeReceiverSnapshot(slot->snapshot, receiver, getPushCount() + 1, timeUs);
+    commit();
+    return true;
+}
+
+/*!
+Pops the oldest frame. Returns false if the queue is empty.
+*/
+bool ReceiverFrameQueue::pop(receiver_frame_t& frame)
+{
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    while (tail != _head.load(std::memory_order_acquire)) {
+        memcpy(&frame, &_frames[tail & (CAPACITY - 1)], sizeof(receiver_frame_t));
+        // if the producer dropped this frame while it was being copied, the copy may be torn, so retry with the new tail
+        if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+Called from the cockpit's task, passes all the queued frames to the cockpit, oldest first.
+If there are no frames, checks failsafe instead, since in decoupled mode the ReceiverTask does not call the cockpit.
+
+Returns the number of frames passed to the cockpit.
+*/
+size_t ReceiverFrameQueue::drain(CockpitBase& cockpit, uint32_t tickCount)
+{
+    size_t count = 0;
+    receiver_frame_t frame; // NOLINT(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    while (pop(frame)) {
+        cockpit.updateControls(frame.controls);
+        ++count;
+    }
+    if (count == 0) {
+        cockpit.checkFailsafe(tickCount);
+    }
+    return count;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CockpitBase.h"
+#include "ReceiverSnapshot.h"
+
+#include <atomic>
+
+#if !defined(RECEIVER_FRAME_QUEUE_CAPACITY)
+#define RECEIVER_FRAME_QUEUE_CAPACITY 8
+#endif
+
+
+/*!
+A frame passed from the ReceiverTask to the cockpit in decoupled mode: the controls, and a timestamped snapshot of all the channels.
+*/
+struct receiver_frame_t {
+    CockpitBase::controls_t controls;
+    receiver_snapshot_t snapshot;
+};
+
+/*!
+Bounded single producer, single consumer queue of receiver frames.
+
+Used to decouple the ReceiverTask from the cockpit, so a slow cockpit does not stall the receiver task and cause UART overruns.
+The ReceiverTask pushes frames, and the cockpit's task calls drain() (or pop()) on its own schedule.
+
+push() is wait free. When the queue is full:
+    with OVERFLOW_DROP_OLDEST the oldest frame is discarded, so the cockpit always gets the newest frames,
+    with OVERFLOW_KEEP_ALL the new frame is discarded, so that no queued frame is lost.
+In both cases the discarded frame is counted as an overflow.
+
+The head and tail indices are on separate cache lines, so the producer and consumer do not contend when on different cores.
+*/
+class ReceiverFrameQueue {
+public:
+    enum { CAPACITY = RECEIVER_FRAME_QUEUE_CAPACITY };
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "RECEIVER_FRAME_QUEUE_CAPACITY must be a power of 2");
+    enum overflow_policy_e { OVERFLOW_DROP_OLDEST, OVERFLOW_KEEP_ALL };
+public:
+    explicit ReceiverFrameQueue(overflow_policy_e overflowPolicy) : _overflowPolicy(overflowPolicy) {}
+    ReceiverFrameQueue() : ReceiverFrameQueue(OVERFLOW_DROP_OLDEST) {}
+private:
+    // ReceiverFrameQueue is not copyable or moveable
+    ReceiverFrameQueue(const ReceiverFrameQueue&) = delete;
+    ReceiverFrameQueue& operator=(const ReceiverFrameQueue&) = delete;
+    ReceiverFrameQueue(ReceiverFrameQueue&&) = delete;
+    ReceiverFrameQueue& operator=(ReceiverFrameQueue&&) = delete;
+public:
+    // producer
+    bool push(const receiver_frame_t& frame);
+    bool push(const CockpitBase::controls_t& controls, const ReceiverBase& receiver, uint32_t timeUs);
+    // consumer
+    bool pop(receiver_frame_t& frame);
+    size_t drain(CockpitBase& cockpit, uint32_t tickCount);
+
+    size_t size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    overflow_policy_e getOverflowPolicy() const { return _overflowPolicy; }
+    uint32_t getPushCount() const { return _pushCount.load(std::memory_order_relaxed); }
+    uint32_t getOverflowCount() const { return _overflowCount.load(std::memory_order_relaxed); } //!< number of frames discarded because the queue was full
+    uint32_t getMaxSize() const { return _maxSize.load(std::memory_order_relaxed); } //!< high water mark
+private:
+    receiver_frame_t* reserve();
+    void commit();
+private:
+    overflow_policy_e _overflowPolicy;
+    alignas(64) std::atomic<uint32_t> _head {}; //!< written by the producer
+    std::atomic<uint32_t> _pushCount {};
+    std::atomic<uint32_t> _overflowCount {};
+    std::atomic<uint32_t> _maxSize {};
+    alignas(64) std::atomic<uint32_t> _tail {}; //!< written by the consumer, and by the producer when it drops the oldest frame
+    alignas(64) std::array<receiver_frame_t, CAPACITY> _frames {};
+};
@@ -0,0 +1,131 @@
+#include "ReceiverCRC.h"
+#include "ReceiverGHST.h"
+
+
+ReceiverGHST::ReceiverGHST(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverGHST::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(getChannelPWM(THROTTLE)) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(getChannelPWM(ROLL)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(getChannelPWM(PITCH)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(getChannelPWM(YAW)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+/*!
+Channels are stored as 11-bit values, which map to PWM as 988 + value/2, so 1024 maps to 1500us.
+*/
+uint16_t ReceiverGHST::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return static_cast<uint16_t>(988U + (_channels[index] >> 1U)); // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+}
+
+uint8_t ReceiverGHST::calculateCRC(const uint8_t* data, size_t length)
+{
+    return crc8_DVB_S2(0, data, length);
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+*/
+bool ReceiverGHST::onDataReceivedFromISR(uint8_t data)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        onFrameTimeout();
+    }
+
+    if (_packetIndex == 0) {
+        if (data != ADDRESS_FLIGHT_CONTROLLER) {
+            onBadSyncByte();
+            return false;
+        }
+        _startTime = timeNowUs;
+    } else if (_packetIndex == 1) {
+        if (data < 2 || data > MAX_PACKET_SIZE - 2) {
+            // invalid length, so resync
+            onBadSyncByte();
+            return false;
+        }
+        _packetSize = static_cast<size_t>(data) + 2;
+    }
+
+    _packetISR[_packetIndex++] = data;
+
+    if (_packetIndex > 1 && _packetIndex == _packetSize) {
+        _packetIndex = 0;
+        _packet = _packetISR;
+        _packetIsEmpty = false;
+        onFrameComplete();
+        return true;
+    }
+    return false;
+}
+
+/*!
+The primary channels are four 12-bit values packed little-endian into 6 bytes, they are reduced to 11 bits.
+*/
+void ReceiverGHST::unpackPrimaryChannels()
+{
+    const uint8_t* payload = &_packet[PAYLOAD_START];
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    _channels[ROLL] = static_cast<uint16_t>((payload[0] | ((payload[1] & 0x0FU) << 8U)) >> 1U);
+    _channels[PITCH] = static_cast<uint16_t>(((payload[1] >> 4U) | (payload[2] << 4U)) >> 1U);
+    _channels[THROTTLE] = static_cast<uint16_t>((payload[3] | ((payload[4] & 0x0FU) << 8U)) >> 1U);
+    _channels[YAW] = static_cast<uint16_t>(((payload[4] >> 4U) | (payload[5] << 4U)) >> 1U);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+/*!
+If the packet is valid then merge its channels into the cached channels and set the packet to empty.
+
+Returns true if a valid RC frame received, false otherwise.
+*/
+bool ReceiverGHST::unpackPacket()
+{
+    const size_t length = _packet[1];
+    // CRC is over type and payload
+    if (calculateCRC(&_packet[2], length - 1) != _packet[length + 1]) {
+        onCrcError();
+        _packetIsEmpty = true;
+        return false;
+    }
+
+    const uint8_t type = _packet[2];
+    const bool isRC_Frame = (type >= FRAMETYPE_RC_CHANNELS_5_TO_8 && type <= FRAMETYPE_RC_CHANNELS_RSSI)
+        || (type >= FRAMETYPE_RC_CHANNELS_12_5_TO_8 && type <= FRAMETYPE_RC_CHANNELS_12_RSSI);
+    if (!isRC_Frame || length != RC_FRAME_LENGTH) {
+        _packetIsEmpty = true;
+        return false;
+    }
+
+    unpackPrimaryChannels();
+
+    const uint8_t group = type & 0x0FU;
+    if (group == (FRAMETYPE_RC_CHANNELS_RSSI & 0x0FU)) {
+        _linkQuality = _packet[AUXILIARY_START];
+        _rssi_dBm = static_cast<int8_t>(-static_cast<int32_t>(_packet[AUXILIARY_START + 1])); // sent as a positive number
+        _rfProtocol = _packet[AUXILIARY_START + 2];
+        _txPower_dBm = static_cast<int8_t>(_packet[AUXILIARY_START + 3]);
+        _linkStatisticsReceived = true;
+    } else {
+        // auxiliary channels are 8-bit, scale them to 11-bit
+        const size_t channelStart = STICK_COUNT + 4*group;
+        for (size_t ii = 0; ii < 4; ++ii) {
+            _channels[channelStart + ii] = static_cast<uint16_t>(_packet[AUXILIARY_START + ii] << 3U);
+        }
+    }
+
+    _packetIsEmpty = false;
+    return true;
+}
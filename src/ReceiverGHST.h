@@ -0,0 +1,80 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+ImmersionRC Ghost (GHST) receiver protocol.
+
+Framing is similar to CRSF, ie
+    1 address byte (has value 0x82 for frames sent to the flight controller)
+    1 length byte, the length of the type, payload, and CRC
+    1 type byte
+    payload
+    1 CRC byte, CRC8 DVB-S2 over the type and payload
+
+RC channels are sent in groups: each RC frame contains the 4 primary channels (as 12-bit values)
+and either 4 auxiliary channels (as 8-bit values) or the link statistics.
+The groups are merged into a cached channel array as they arrive.
+*/
+class ReceiverGHST : public ReceiverSerial {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 16;
+    enum { BAUD_RATE = 420000 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1
+    enum { TIME_NEEDED_PER_FRAME_US = 700 }; // maximum size frame at 420000 baud, with margin
+
+    enum address_e {
+        ADDRESS_TRANSMITTER = 0x80,
+        ADDRESS_TX_MODULE_ALL = 0x81,
+        ADDRESS_FLIGHT_CONTROLLER = 0x82,
+        ADDRESS_GOGGLES = 0x83,
+        ADDRESS_RECEIVER = 0x89
+    };
+    enum frametype_e {
+        FRAMETYPE_RC_CHANNELS_5_TO_8 = 0x10,
+        FRAMETYPE_RC_CHANNELS_9_TO_12 = 0x11,
+        FRAMETYPE_RC_CHANNELS_13_TO_16 = 0x12,
+        FRAMETYPE_RC_CHANNELS_RSSI = 0x13,
+        // the 12-bit auxiliary channel ("HS4_12") variants have the same layout
+        FRAMETYPE_RC_CHANNELS_12_5_TO_8 = 0x30,
+        FRAMETYPE_RC_CHANNELS_12_9_TO_12 = 0x31,
+        FRAMETYPE_RC_CHANNELS_12_13_TO_16 = 0x32,
+        FRAMETYPE_RC_CHANNELS_12_RSSI = 0x33
+    };
+    enum { RC_FRAME_PAYLOAD_SIZE = 10 }; // 6 bytes of primary channels, 4 bytes of auxiliary channels or link statistics
+    enum { RC_FRAME_LENGTH = RC_FRAME_PAYLOAD_SIZE + 2 }; // type, payload, and CRC
+    enum { MAX_PACKET_SIZE = 24 };
+public:
+    explicit ReceiverGHST(SerialPort& serialPort);
+private:
+    // ReceiverGHST is not copyable or moveable
+    ReceiverGHST(const ReceiverGHST&) = delete;
+    ReceiverGHST& operator=(const ReceiverGHST&) = delete;
+    ReceiverGHST(ReceiverGHST&&) = delete;
+    ReceiverGHST& operator=(ReceiverGHST&&) = delete;
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    static uint8_t calculateCRC(const uint8_t* data, size_t length);
+    uint8_t getLinkQuality() const { return _linkQuality; } //!< link quality, percent
+    int8_t getRSSI_dBm() const { return _rssi_dBm; }
+    uint8_t getRF_Protocol() const { return _rfProtocol; }
+    int8_t getTxPower_dBm() const { return _txPower_dBm; }
+    bool isLinkStatisticsReceived() const { return _linkStatisticsReceived; }
+private:
+    void unpackPrimaryChannels();
+private:
+    enum { PAYLOAD_START = 3, AUXILIARY_START = PAYLOAD_START + 6 };
+    std::array<uint8_t, MAX_PACKET_SIZE> _packetISR {};
+    std::array<uint8_t, MAX_PACKET_SIZE> _packet {};
+    size_t _packetSize {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {}; //!< 11-bit channel values
+    uint8_t _linkQuality {};
+    int8_t _rssi_dBm {};
+    uint8_t _rfProtocol {};
+    int8_t _txPower_dBm {};
+    uint8_t _linkStatisticsReceived {false};
+};
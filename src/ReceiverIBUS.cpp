@@ -34,8 +34,7 @@ bool ReceiverIBUS::onDataReceivedFromISR(uint8_t data)
     const timeUs32_t timeNowUs = timeUs();
     enum { TIME_ALLOWANCE = 500 };
     if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
-        _packetIndex = 0;
-        ++_droppedPacketCount;
+        onFrameTimeout();
     }
 
     enum { IA6_SYNC_BYTE = 0x55 };
@@ -52,6 +51,7 @@ bool ReceiverIBUS::onDataReceivedFromISR(uint8_t data)
             _frameSize = IA6_FRAME_SIZE;
             _channelOffset = 1;
         } else if (_syncByte != data) {
+            onBadSyncByte();
             return false;
         }
         _startTime = timeNowUs;
@@ -62,6 +62,7 @@ bool ReceiverIBUS::onDataReceivedFromISR(uint8_t data)
     if (_packetIndex == PACKET_SIZE) {
         _packetIndex = 0;
         _packet = _packetISR;
+        onFrameComplete();
         return true;
     }
     return false;
@@ -87,6 +88,7 @@ Returns true if a valid packet received, false otherwise.
 bool ReceiverIBUS::unpackPacket()
 {
     if (calculateChecksum() != getReceivedChecksum()) {
+        onCrcError();
         _packetIsEmpty = true;
         return false;
     }
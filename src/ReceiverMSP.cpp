@@ -0,0 +1,182 @@
+#include "ReceiverCRC.h"
+#include "ReceiverMSP.h"
+
+
+ReceiverMSP::ReceiverMSP(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverMSP::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(_channels[THROTTLE]) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(_channels[ROLL]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(_channels[PITCH]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(_channels[YAW]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+uint16_t ReceiverMSP::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return _channels[index];
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+
+Parses the frame one byte at a time, accumulating the checksum as it goes.
+*/
+bool ReceiverMSP::onDataReceivedFromISR(uint8_t data) // NOLINT(readability-function-cognitive-complexity)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (_state != STATE_IDLE && timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        // _packetIndex is the payload index, so the bytes of the frame are counted separately
+        onFrameTimeout(_frameByteCountISR);
+        _state = STATE_IDLE;
+    }
+    ++_frameByteCountISR;
+
+    switch (_state) {
+    case STATE_IDLE:
+        if (data == '$') {
+            _startTime = timeNowUs;
+            _frameByteCountISR = 1;
+            _state = STATE_HEADER_START;
+        }
+        break;
+    case STATE_HEADER_START:
+        _state = (data == 'M') ? STATE_HEADER_V1 : (data == 'X') ? STATE_HEADER_V2 : STATE_IDLE;
+        break;
+    case STATE_HEADER_V1:
+        _state = (data == '<') ? STATE_V1_SIZE : STATE_IDLE;
+        _packetISR.version = MSP_V1;
+        _packetISR.flags = 0;
+        break;
+    case STATE_HEADER_V2:
+        _state = (data == '<') ? STATE_V2_FLAGS : STATE_IDLE;
+        _packetISR.version = MSP_V2;
+        break;
+    case STATE_V1_SIZE:
+        _packetISR.payloadSize = data;
+        _checksumISR = data;
+        _state = (data > MAX_PAYLOAD_SIZE) ? STATE_IDLE : STATE_V1_COMMAND;
+        break;
+    case STATE_V1_COMMAND:
+        _packetISR.command = data;
+        _checksumISR ^= data;
+        _packetIndex = 0;
+        _state = (_packetISR.payloadSize > 0) ? STATE_PAYLOAD : STATE_CHECKSUM;
+        break;
+    case STATE_V2_FLAGS:
+        _packetISR.flags = data;
+        _checksumISR = crc8_DVB_S2(0, data);
+        _state = STATE_V2_COMMAND_LOW;
+        break;
+    case STATE_V2_COMMAND_LOW:
+        _packetISR.command = data;
+        _checksumISR = crc8_DVB_S2(_checksumISR, data);
+        _state = STATE_V2_COMMAND_HIGH;
+        break;
+    case STATE_V2_COMMAND_HIGH:
+        _packetISR.command |= static_cast<uint16_t>(data << 8U);
+        _checksumISR = crc8_DVB_S2(_checksumISR, data);
+        _state = STATE_V2_SIZE_LOW;
+        break;
+    case STATE_V2_SIZE_LOW:
+        _packetISR.payloadSize = data;
+        _checksumISR = crc8_DVB_S2(_checksumISR, data);
+        _state = STATE_V2_SIZE_HIGH;
+        break;
+    case STATE_V2_SIZE_HIGH:
+        _packetISR.payloadSize |= static_cast<uint16_t>(data << 8U);
+        _checksumISR = crc8_DVB_S2(_checksumISR, data);
+        _packetIndex = 0;
+        _state = (_packetISR.payloadSize > MAX_PAYLOAD_SIZE) ? STATE_IDLE : (_packetISR.payloadSize > 0) ? STATE_PAYLOAD : STATE_CHECKSUM;
+        break;
+    case STATE_PAYLOAD:
+        _packetISR.payload[_packetIndex++] = data;
+        _checksumISR = (_packetISR.version == MSP_V1) ? static_cast<uint8_t>(_checksumISR ^ data) : crc8_DVB_S2(_checksumISR, data);
+        if (_packetIndex == _packetISR.payloadSize) {
+            _state = STATE_CHECKSUM;
+        }
+        break;
+    case STATE_CHECKSUM:
+        _state = STATE_IDLE;
+        if (data != _checksumISR) {
+            onCrcError();
+            return false;
+        }
+        _packet = _packetISR;
+        _packetIsEmpty = false;
+        return true;
+    }
+    return false;
+}
+
+/*!
+Sends an empty reply to the command in _packet, using the next buffer in the pool.
+
+The reply is written to a buffer in the pool rather than to the stack, so it remains valid while the serial port sends it.
+*/
+void ReceiverMSP::sendResponse(bool isError)
+{
+    response_t& response = _responses[_responseIndex];
+    _responseIndex = (_responseIndex + 1) % RESPONSE_POOL_SIZE;
+
+    size_t pos = 0;
+    response.data[pos++] = '$';
+    if (_packet.version == MSP_V1) {
+        response.data[pos++] = 'M';
+        response.data[pos++] = isError ? '!' : '>';
+        response.data[pos++] = 0; // size
+        response.data[pos++] = static_cast<uint8_t>(_packet.command);
+        response.data[pos++] = static_cast<uint8_t>(_packet.command); // checksum is size XOR command
+    } else {
+        response.data[pos++] = 'X';
+        response.data[pos++] = isError ? '!' : '>';
+        response.data[pos++] = 0; // flags
+        response.data[pos++] = static_cast<uint8_t>(_packet.command);
+        response.data[pos++] = static_cast<uint8_t>(_packet.command >> 8U);
+        response.data[pos++] = 0; // size
+        response.data[pos++] = 0;
+        response.data[pos] = crc8_DVB_S2(0, &response.data[3], pos - 3);
+        ++pos;
+    }
+    response.length = pos;
+    _serialPort.write(&response.data[0], response.length);
+}
+
+/*!
+Unpack the packet into the member data and set the packet to empty. The checksum has already been checked in the ISR.
+
+Returns true if a valid MSP_SET_RAW_RC packet received, false otherwise.
+
+MSP_SET_RAW_RC payload is 2 bytes per channel, in microseconds, in AETR (Ailerons, Elevator, Throttle, Rudder) order, ie ROLL, PITCH, THROTTLE, YAW.
+*/
+bool ReceiverMSP::unpackPacket()
+{
+    _packetIsEmpty = true;
+
+    if (_packet.command != MSP_SET_RAW_RC) {
+        sendResponse(true);
+        return false;
+    }
+
+    const size_t channelCount = _packet.payloadSize / 2;
+    if (channelCount < STICK_COUNT || (_packet.payloadSize & 1U)) {
+        sendResponse(true);
+        return false;
+    }
+    for (size_t ii = 0; ii < channelCount; ++ii) {
+        _channels[ii] = static_cast<uint16_t>(_packet.payload[2*ii] | (_packet.payload[2*ii + 1] << 8U));
+    }
+    _channelCount = static_cast<uint32_t>(channelCount);
+    sendResponse(false);
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+MultiWii Serial Protocol (MSP) receiver, for control by a companion computer or ground station.
+
+Accepts MSP_SET_RAW_RC commands in MSP v1 and MSP v2 framing.
+
+MSP v1 frames are
+    '$', 'M', '<', 1 size byte, 1 command byte, payload, 1 checksum byte (XOR of size, command and payload)
+MSP v2 frames are
+    '$', 'X', '<', 1 flag byte, 2 command bytes, 2 size bytes, payload, 1 checksum byte (CRC8 DVB-S2 of flag, command, size and payload)
+Multi-byte values are little-endian.
+
+The checksum is accumulated as each byte arrives, so a complete frame is passed on for unpacking only if it is valid.
+Each command is acknowledged with an empty reply (or an error reply for unsupported commands) from a fixed pool of preformatted buffers.
+
+There is no failsafe flag in MSP: if the companion computer stops sending MSP_SET_RAW_RC then no packets are received and the cockpit failsafe applies.
+*/
+class ReceiverMSP : public ReceiverSerial {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 18;
+    enum { BAUD_RATE = 115200 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1
+    enum { TIME_NEEDED_PER_FRAME_US = 10000 }; // discard any partial frame after this time
+
+    enum { MSP_SET_RAW_RC = 200 };
+    enum { MSP_V1 = 1, MSP_V2 = 2 };
+    enum { MAX_PAYLOAD_SIZE = 2 * CHANNEL_COUNT };
+    enum { RESPONSE_POOL_SIZE = 4, MAX_RESPONSE_SIZE = 9 }; // MSP v2 empty reply is 9 bytes
+    struct msp_packet_t {
+        uint16_t command;
+        uint16_t payloadSize;
+        uint8_t version;
+        uint8_t flags;
+        std::array<uint8_t, MAX_PAYLOAD_SIZE> payload;
+    };
+    struct response_t {
+        std::array<uint8_t, MAX_RESPONSE_SIZE> data;
+        size_t length;
+    };
+public:
+    explicit ReceiverMSP(SerialPort& serialPort);
+private:
+    // ReceiverMSP is not copyable or moveable
+    ReceiverMSP(const ReceiverMSP&) = delete;
+    ReceiverMSP& operator=(const ReceiverMSP&) = delete;
+    ReceiverMSP(ReceiverMSP&&) = delete;
+    ReceiverMSP& operator=(ReceiverMSP&&) = delete;
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    uint32_t getChannelCount() const { return _channelCount; } //!< number of channels in the most recent MSP_SET_RAW_RC
+// for testing
+    const response_t& getLastResponse() const { return _responses[(_responseIndex + RESPONSE_POOL_SIZE - 1) % RESPONSE_POOL_SIZE]; }
+private:
+    enum state_e {
+        STATE_IDLE,
+        STATE_HEADER_START,
+        STATE_HEADER_V1,
+        STATE_HEADER_V2,
+        STATE_V1_SIZE,
+        STATE_V1_COMMAND,
+        STATE_V2_FLAGS,
+        STATE_V2_COMMAND_LOW,
+        STATE_V2_COMMAND_HIGH,
+        STATE_V2_SIZE_LOW,
+        STATE_V2_SIZE_HIGH,
+        STATE_PAYLOAD,
+        STATE_CHECKSUM
+    };
+    void sendResponse(bool isError);
+private:
+    msp_packet_t _packetISR {};
+    msp_packet_t _packet {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {};
+    uint32_t _channelCount {};
+    state_e _state {STATE_IDLE};
+    uint8_t _checksumISR {};
+    size_t _frameByteCountISR {}; //!< number of bytes received in the current frame, including the header
+    std::array<response_t, RESPONSE_POOL_SIZE> _responses {};
+    size_t _responseIndex {};
+};
@@ -0,0 +1,146 @@
+#include "ReceiverPPM.h"
+
+#include <utility>
+
+
+ReceiverPPM::ReceiverPPM() = default;
+
+/*!
+Waits for onPulseEdgeFromISR() to signal that a frame is complete.
+
+Returns the number of frames completed since the last wait, 0 if timeout.
+*/
+int32_t ReceiverPPM::WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait)
+{
+    return _dataReady.WAIT(ticksToWait);
+}
+
+/*!
+Called from the timer capture ISR with the time of each edge of the pulse train.
+
+Does a constant amount of work per edge: only at the end of a frame is the (fixed size) frame copied.
+
+Returns true if the edge completed a valid frame.
+*/
+bool ReceiverPPM::onPulseEdgeFromISR(timeUs32_t edgeTimeUs)
+{
+    const uint32_t widthUs = edgeTimeUs - _previousEdgeTimeUs;
+    _previousEdgeTimeUs = edgeTimeUs;
+
+    if (widthUs >= SYNC_GAP_MIN_US) {
+        // sync gap, so end of frame
+        bool frameComplete = false;
+        const uint32_t channelCount = _frameISR.channelCount;
+        if (_frameValidISR && channelCount >= MIN_CHANNEL_COUNT) {
+            _stableFrameCountISR = (channelCount == _previousChannelCountISR) ? _stableFrameCountISR + 1 : 0;
+            _previousChannelCountISR = channelCount;
+            if (_stableFrameCountISR >= STABLE_FRAME_COUNT_REQUIRED - 1) {
+                _frame = _frameISR;
+                _packetIsEmpty = false;
+                frameComplete = true;
+                _dataReady.SIGNAL_FROM_ISR();
+            }
+        } else if (_frameValidISR) {
+            // too few channels, so the channel count has changed or the frame was glitched: restart the stability check
+            _stableFrameCountISR = 0;
+            _previousChannelCountISR = channelCount;
+            ++_rejectedFrameCount;
+        }
+        _frameISR.channelCount = 0;
+        _frameValidISR = true;
+        return frameComplete;
+    }
+
+    if (!_frameValidISR) {
+        // waiting for sync gap
+        return false;
+    }
+    if (widthUs < PULSE_MIN_US || widthUs > PULSE_MAX_US || _frameISR.channelCount >= CHANNEL_COUNT) {
+        // outlier, so reject the whole frame
+        _frameValidISR = false;
+        _stableFrameCountISR = 0;
+        ++_rejectedFrameCount;
+        return false;
+    }
+    _frameISR.pulses[_frameISR.channelCount++] = static_cast<uint16_t>(widthUs);
+    return false;
+}
+
+uint16_t ReceiverPPM::median(uint16_t a, uint16_t b, uint16_t c)
+{
+    if (a > b) {
+        std::swap(a, b);
+    }
+    // now a <= b
+    if (c <= a) {
+        return a;
+    }
+    return (c >= b) ? b : c;
+}
+
+/*!
+Copy the frame into the channels, applying a median-of-3 filter, and set the packet to empty.
+
+Returns true if a frame was received, false otherwise.
+*/
+bool ReceiverPPM::unpackPacket()
+{
+    if (_packetIsEmpty) {
+        return false;
+    }
+    // take a copy, in case the ISR completes another frame while unpacking
+    const frame_t frame = _frame;
+    _packetIsEmpty = true;
+
+    if (frame.channelCount != _channelCount) {
+        // channel count changed, so restart the filter
+        for (size_t ii = 0; ii < frame.channelCount; ++ii) {
+            _history[ii].fill(frame.pulses[ii]);
+        }
+        _channelCount = frame.channelCount;
+        _auxiliaryChannelCount = _channelCount - STICK_COUNT;
+    }
+
+    // PPM channel order is set in the receiver, AETR (Ailerons, Elevator, Throttle, Rudder), ie ROLL, PITCH, THROTTLE, YAW is assumed
+    for (size_t ii = 0; ii < _channelCount; ++ii) {
+        auto& history = _history[ii];
+        history[_historyIndex] = frame.pulses[ii];
+        _channels[ii] = median(history[0], history[1], history[2]);
+    }
+    _historyIndex = (_historyIndex + 1) % 3;
+    return true;
+}
+
+bool ReceiverPPM::update(uint32_t tickCountDelta)
+{
+    if (!unpackPacket()) {
+        return false;
+    }
+
+    _packetReceived = true;
+    ++_packetCount;
+    _tickCountDelta = tickCountDelta;
+
+    // NOTE: there is no mutex around this flag
+    _newPacketAvailable = true;
+    return true;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverPPM::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(_channels[THROTTLE]) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(_channels[ROLL]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(_channels[PITCH]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(_channels[YAW]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+uint16_t ReceiverPPM::getChannelPWM(size_t index) const
+{
+    if (index >= _channelCount) {
+        return CHANNEL_LOW;
+    }
+    return _channels[index];
+}
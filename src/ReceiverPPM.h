@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ReceiverBase.h"
+#include "TaskSignal.h"
+
+#include <TimeMicroseconds.h>
+#include <array>
+
+
+/*!
+PPM (CPPM) receiver, decodes a single-wire pulse train.
+
+The pulse train is a sequence of channel pulses followed by a sync gap. Each channel value is the time between
+successive edges (of the same polarity), and the sync gap is a time between edges longer than any channel pulse.
+
+The receiver does not own the hardware timer: the timer input capture (or GPIO edge) ISR converts the capture value to microseconds
+and calls onPulseEdgeFromISR(). This keeps the hardware specific code out of the receiver, and allows edge sequences to be injected in tests.
+
+onPulseEdgeFromISR() does a constant amount of work per edge. Frames with any pulse out of range are rejected,
+and the channel count must be the same for consecutive frames before a frame is accepted.
+Unpacking applies a median-of-3 filter to each channel to remove single-frame glitches.
+*/
+class ReceiverPPM : public ReceiverBase {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 12;
+    enum { MIN_CHANNEL_COUNT = 8 };
+    enum { SYNC_GAP_MIN_US = 2700, PULSE_MIN_US = 750, PULSE_MAX_US = 2250 };
+    enum { STABLE_FRAME_COUNT_REQUIRED = 2 }; // number of consecutive frames with the same channel count needed before frames are accepted
+public:
+    ReceiverPPM();
+private:
+    // ReceiverPPM is not copyable or moveable
+    ReceiverPPM(const ReceiverPPM&) = delete;
+    ReceiverPPM& operator=(const ReceiverPPM&) = delete;
+    ReceiverPPM(ReceiverPPM&&) = delete;
+    ReceiverPPM& operator=(ReceiverPPM&&) = delete;
+public:
+    virtual int32_t WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) override;
+    virtual bool update(uint32_t tickCountDelta) override;
+    virtual bool unpackPacket() override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    bool onPulseEdgeFromISR(timeUs32_t edgeTimeUs);
+    bool isPacketEmpty() const { return _packetIsEmpty; }
+    uint32_t getChannelCount() const { return _channelCount; }
+    uint32_t getRejectedFrameCount() const { return _rejectedFrameCount; }
+    static uint16_t median(uint16_t a, uint16_t b, uint16_t c);
+private:
+    struct frame_t {
+        std::array<uint16_t, CHANNEL_COUNT> pulses;
+        uint32_t channelCount;
+    };
+    // written by ISR
+    frame_t _frameISR {};
+    timeUs32_t _previousEdgeTimeUs {};
+    uint32_t _previousChannelCountISR {};
+    uint32_t _stableFrameCountISR {};
+    uint8_t _frameValidISR {false}; //!< false until the first sync gap is seen, and after an out of range pulse
+    volatile bool _packetIsEmpty {true};
+    uint32_t _rejectedFrameCount {};
+    frame_t _frame {}; //!< last complete frame, copied from _frameISR
+    // used by unpackPacket
+    std::array<std::array<uint16_t, 3>, CHANNEL_COUNT> _history {}; //!< last three values of each channel, for the median filter
+    std::array<uint16_t, CHANNEL_COUNT> _channels {};
+    uint32_t _channelCount {};
+    size_t _historyIndex {};
+    TaskSignal _dataReady;
+};
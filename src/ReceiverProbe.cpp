@@ -0,0 +1,41 @@
+#if defined(LIBRARY_RECEIVER_USE_PROBES)
+
+#include "ReceiverProbe.h"
+
+
+std::array<ReceiverProbe::stats_t, ReceiverProbe::PROBE_COUNT> ReceiverProbe::stats {};
+
+/*!
+Enables the cycle counter, on Cortex-M it is disabled by default. Also resets the statistics.
+*/
+void ReceiverProbe::init()
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    *reinterpret_cast<volatile uint32_t*>(DEMCR) |= DEMCR_TRCENA; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+    *reinterpret_cast<volatile uint32_t*>(DWT_CYCCNT) = 0; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+    *reinterpret_cast<volatile uint32_t*>(DWT_CTRL) |= DWT_CTRL_CYCCNTENA; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+#endif
+    reset();
+}
+
+void ReceiverProbe::reset()
+{
+    for (stats_t& probeStats : stats) {
+        probeStats = { .count = 0, .minCycles = UINT32_MAX, .maxCycles = 0, .totalCycles = 0 };
+    }
+}
+
+void ReceiverProbe::record(probe_id_e probeId, uint32_t cycles)
+{
+    stats_t& probeStats = stats[probeId];
+    if (probeStats.count == 0 || cycles < probeStats.minCycles) {
+        probeStats.minCycles = cycles;
+    }
+    if (cycles > probeStats.maxCycles) {
+        probeStats.maxCycles = cycles;
+    }
+    probeStats.totalCycles += cycles;
+    ++probeStats.count;
+}
+
+#endif // LIBRARY_RECEIVER_USE_PROBES
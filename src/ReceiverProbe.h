@@ -0,0 +1,99 @@
+#pragma once
+
+/*!
+Scoped cycle count probes for measuring the cost of the receive path on target.
+
+Enabled by defining LIBRARY_RECEIVER_USE_PROBES, otherwise RECEIVER_PROBE() expands to nothing and there is no probe code or storage.
+
+Put RECEIVER_PROBE(<probe id>) at the start of a scope, the cycles from there to the end of the scope are accumulated in that probe's statistics.
+The cycle counter used depends on the platform:
+    Cortex-M3/M4/M7/M33: DWT CYCCNT, in CPU cycles
+    ESP32: the CPU cycle count register (ccount on Xtensa)
+    RP2040 (Cortex-M0+, which has no cycle counter): the microsecond timer
+    x86 native builds: rdtsc, in TSC ticks
+    other native builds: clock_gettime(CLOCK_MONOTONIC), in nanoseconds
+The counter is 32 bits, so a single probed scope must take less than one counter wrap.
+
+Statistics are updated without locking: each probe should be used only in one context (for example ON_DATA_RECEIVED only from the ISR),
+and a reader, such as the telemetry task, may see a partially updated set of statistics.
+*/
+#if defined(LIBRARY_RECEIVER_USE_PROBES)
+
+#include <array>
+#include <cstdint>
+
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+#include <esp_cpu.h>
+#elif defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+#if !defined(__ARM_ARCH_8M_MAIN__)
+#include <pico/time.h>
+#endif
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__arm__)
+#include <ctime>
+#endif
+
+
+class ReceiverProbe {
+public:
+    enum probe_id_e { ON_DATA_RECEIVED, UNPACK_PACKET, UPDATE, TASK_LOOP, PROBE_COUNT };
+    struct stats_t {
+        uint32_t count;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+    };
+public:
+    explicit ReceiverProbe(probe_id_e probeId) : _probeId(probeId), _startCycles(cycles()) {}
+    ~ReceiverProbe() { record(_probeId, cycles() - _startCycles); }
+private:
+    // ReceiverProbe is not copyable or moveable
+    ReceiverProbe(const ReceiverProbe&) = delete;
+    ReceiverProbe& operator=(const ReceiverProbe&) = delete;
+    ReceiverProbe(ReceiverProbe&&) = delete;
+    ReceiverProbe& operator=(ReceiverProbe&&) = delete;
+public:
+    static void init();
+    static void reset();
+    static void record(probe_id_e probeId, uint32_t cycles);
+    static const stats_t& getStats(probe_id_e probeId) { return stats[probeId]; }
+    static uint32_t getMeanCycles(probe_id_e probeId) { return stats[probeId].count == 0 ? 0 : static_cast<uint32_t>(stats[probeId].totalCycles / stats[probeId].count); }
+    static inline uint32_t cycles() {
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+        return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+        return *reinterpret_cast<volatile uint32_t*>(DWT_CYCCNT); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+#elif defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+        return time_us_32();
+#elif defined(__x86_64__) || defined(__i386__)
+        return static_cast<uint32_t>(__rdtsc());
+#elif !defined(__arm__)
+        timespec now {};
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        enum { NANOSECONDS_PER_SECOND = 1000000000 };
+        return static_cast<uint32_t>(now.tv_sec * NANOSECONDS_PER_SECOND + now.tv_nsec);
+#else
+        return 0;
+#endif
+    }
+public:
+    // Cortex-M debug registers used to enable and read the cycle counter
+    static constexpr uint32_t DWT_CTRL = 0xE0001000;
+    static constexpr uint32_t DWT_CYCCNT = 0xE0001004;
+    static constexpr uint32_t DEMCR = 0xE000EDFC;
+    static constexpr uint32_t DEMCR_TRCENA = 1U << 24U;
+    static constexpr uint32_t DWT_CTRL_CYCCNTENA = 1U;
+private:
+    static std::array<stats_t, PROBE_COUNT> stats;
+    const probe_id_e _probeId;
+    const uint32_t _startCycles;
+};
+
+#define RECEIVER_PROBE(probeId) const ReceiverProbe receiverProbe_##probeId(ReceiverProbe::probeId) // NOLINT(cppcoreguidelines-macro-usage)
+
+#else
+
+#define RECEIVER_PROBE(probeId) // NOLINT(cppcoreguidelines-macro-usage)
+
+#endif // LIBRARY_RECEIVER_USE_PROBES
@@ -34,12 +34,12 @@ bool ReceiverSBUS::onDataReceivedFromISR(uint8_t data)
     const timeUs32_t timeNowUs = timeUs();
     enum { TIME_ALLOWANCE = 500 };
     if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US + TIME_ALLOWANCE) { // cppcheck-suppress unsignedLessThanZero
-        _packetIndex = 0;
-        ++_droppedPacketCount;
+        onFrameTimeout();
     }
 
     if (_packetIndex == 0) {
         if (data != SBUS_START_BYTE) {
+            onBadSyncByte();
             _packetIsEmpty = true;
             return false;
         }
@@ -49,18 +49,50 @@ bool ReceiverSBUS::onDataReceivedFromISR(uint8_t data)
     _packetISR[_packetIndex++] = data;
 
     if (_packetIndex == PACKET_SIZE) {
-        _packetIndex = 0;
         if (_packetISR[PACKET_SIZE - 1] != SBUS_END_BYTE) {
-            ++_errorPacketCount;
+            // SBUS has no CRC, so a bad end byte is the only sign that the frame was out of sync
+            --_packetIndex; // the end byte is counted by onBadSyncByte()
+            onBadSyncByte();
             _packetIsEmpty = true;
             return false;
         }
+        _packetIndex = 0;
         _packet = _packetISR;
+        _packetIsEmpty = false;
+        onFrameComplete();
         return true;
     }
     return false;
 }
 
+/*!
+Unpacks 16 11-bit channels from the 22 bytes of `packedChannels`, the raw channel values are in the range [0,2047].
+
+This is shared by the protocols that use the SBUS channel layout.
+*/
+void ReceiverSBUS::unpackChannels(uint16_t* channels, const uint8_t* packedChannels) // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const uint8_t* p = packedChannels;
+    channels[0]  = static_cast<uint16_t>((p[0]     | p[1]<<8) & 0x07FF);
+    channels[1]  = static_cast<uint16_t>((p[1]>>3  | p[2]<<5) & 0x07FF);
+    channels[2]  = static_cast<uint16_t>((p[2]>>6  | p[3]<<2  | p[4]<<10) & 0x07FF);
+    channels[3]  = static_cast<uint16_t>((p[4]>>1  | p[5]<<7) & 0x07FF);
+    channels[4]  = static_cast<uint16_t>((p[5]>>4  | p[6]<<4) & 0x07FF);
+    channels[5]  = static_cast<uint16_t>((p[6]>>7  | p[7]<<1  | p[8]<<9) & 0x07FF);
+    channels[6]  = static_cast<uint16_t>((p[8]>>2  | p[9]<<6) & 0x07FF);
+    channels[7]  = static_cast<uint16_t>((p[9]>>5  | p[10]<<3) & 0x07FF);
+    channels[8]  = static_cast<uint16_t>((p[11]    | p[12]<<8) & 0x07FF);
+    channels[9]  = static_cast<uint16_t>((p[12]>>3 | p[13]<<5) & 0x07FF);
+    channels[10] = static_cast<uint16_t>((p[13]>>6 | p[14]<<2 | p[15]<<10) & 0x07FF);
+    channels[11] = static_cast<uint16_t>((p[15]>>1 | p[16]<<7) & 0x07FF);
+    channels[12] = static_cast<uint16_t>((p[16]>>4 | p[17]<<4) & 0x07FF);
+    channels[13] = static_cast<uint16_t>((p[17]>>7 | p[18]<<1 | p[19]<<9) & 0x07FF);
+    channels[14] = static_cast<uint16_t>((p[19]>>2 | p[20]<<6) & 0x07FF);
+    channels[15] = static_cast<uint16_t>((p[20]>>5 | p[21]<<3) & 0x07FF);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
 /*!
 If the packet is valid then unpack it into the member data and set the packet to empty.
 
@@ -84,40 +116,12 @@ bool ReceiverSBUS::unpackPacket()
     }
     // SBUS uses AETR (Ailerons, Elevator, Throttle, Rudder), ie ROLL, PITCH, THROTTLE, YAW
     // This is the default, so no reordering required
-    _channels[0]  = _packet[1]     | _packet[2]<<8;
-    _channels[1]  = _packet[2]>>3  | _packet[3]<<5;
-    _channels[2]  = _packet[3]>>6  | _packet[4]<<2  | _packet[5]<<10;
-    _channels[3]  = _packet[5]>>1  | _packet[6]<<7;
-    _channels[4]  = _packet[6]>>4  | _packet[7]<<4;
-    _channels[5]  = _packet[7]>>7  | _packet[8]<<1  | _packet[9]<<9;
-    _channels[6]  = _packet[9]>>2  | _packet[10]<<6;
-    _channels[7]  = _packet[10]>>5 | _packet[11]<<3;
-    _channels[8]  = _packet[12]    | _packet[13]<<8;
-    _channels[9]  = _packet[13]>>3 | _packet[14]<<5;
-    _channels[10] = _packet[14]>>6 | _packet[15]<<2 | _packet[16]<<10;
-    _channels[11] = _packet[16]>>1 | _packet[17]<<7;
-    _channels[12] = _packet[17]>>4 | _packet[18]<<4;
-    _channels[13] = _packet[18]>>7 | _packet[19]<<1 | _packet[20]<<9;
-    _channels[14] = _packet[20]>>2 | _packet[21]<<6;
-    _channels[15] = _packet[21]>>5 | _packet[22]<<3;
-
+    unpackChannels(&_channels[0], &_packet[1]);
 
     // map range [192,1792] to [1000,2000]
-#if true
     for (size_t ii = 0; ii < CHANNEL_11_BIT_COUNT; ++ii) {
-        _channels[ii] &= 0x07FF;
-        _channels[ii] = static_cast<uint16_t>(5.0F * static_cast<float>(_channels[ii]) / 8.0F) + 880;
-    }
-#else
-    for (size_t ii = 0; ii < 16; ++ii) {
-        uint32_t channel =  _channels[ii];
-        channel <<= 16;
-        channel *=5;
-        channel >>= 19;
-        channel += 880;
-        _channels[ii] = static_cast<uint16_t>(channel);
+        _channels[ii] = channelToPWM(_channels[ii]);
     }
-#endif
 
     enum { FLAG_CHANNEL_16 = 0x01, FLAG_CHANNEL_17 = 0x02, FLAG_LOST_FRAME = 0x04, FLAG_LOST_SIGNAL = 0x08 };
     const uint8_t flags = _packet[23];
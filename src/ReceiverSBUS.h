@@ -28,6 +28,8 @@ public:
     virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
     virtual uint16_t getChannelPWM(size_t index) const override;
     virtual bool unpackPacket() override;
+    static void unpackChannels(uint16_t* channels, const uint8_t* packedChannels);
+    static uint16_t channelToPWM(uint16_t channel) { return static_cast<uint16_t>(5.0F * static_cast<float>(channel & 0x07FFU) / 8.0F) + 880; }
 private:
     enum { PACKET_SIZE = 25 };
     std::array<uint8_t, PACKET_SIZE> _packetISR {};
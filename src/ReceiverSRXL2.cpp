@@ -0,0 +1,270 @@
+#include "ReceiverCRC.h"
+#include "ReceiverSRXL2.h"
+
+
+ReceiverSRXL2::ReceiverSRXL2(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverSRXL2::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(getChannelPWM(THROTTLE)) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(getChannelPWM(ROLL)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(getChannelPWM(PITCH)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(getChannelPWM(YAW)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+/*!
+SRXL2 channel values are 16-bit with 0x8000 as center. The top 11 bits are the Spektrum 2048 channel value,
+which maps to PWM as 903 + 0.583 * value, so 1024 maps to 1500us.
+*/
+uint16_t ReceiverSRXL2::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return static_cast<uint16_t>(903U + ((static_cast<uint32_t>(_channels[index]) >> 5U) * 583U + 500U) / 1000U); // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+}
+
+uint16_t ReceiverSRXL2::calculateCRC(const uint8_t* data, size_t length)
+{
+    return crc16_CCITT(0, data, length);
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+*/
+bool ReceiverSRXL2::onDataReceivedFromISR(uint8_t data)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        onFrameTimeout();
+    }
+
+    if (_packetIndex == 0) {
+        if (data != SRXL2_SYNC_BYTE) {
+            onBadSyncByte();
+            return false;
+        }
+        _startTime = timeNowUs;
+    } else if (_packetIndex == 2) {
+        if (data < MIN_PACKET_LENGTH || data > MAX_PACKET_LENGTH) {
+            // invalid length, so resync
+            onBadSyncByte();
+            return false;
+        }
+        _packetLength = data;
+    }
+
+    _packetISR[_packetIndex++] = data;
+
+    if (_packetIndex > 2 && _packetIndex == _packetLength) {
+        _packetIndex = 0;
+        _packet = _packetISR;
+        _packetIsEmpty = false;
+        onFrameComplete();
+        return true;
+    }
+    return false;
+}
+
+void ReceiverSRXL2::setState(state_e state)
+{
+    _state = state;
+}
+
+/*!
+Sets the CRC of the packet in _txPacket and sends it.
+*/
+void ReceiverSRXL2::sendPacket(size_t length)
+{
+    const uint16_t crc = calculateCRC(&_txPacket[0], length - 2);
+    _txPacket[length - 2] = static_cast<uint8_t>(crc >> 8U);
+    _txPacket[length - 1] = static_cast<uint8_t>(crc);
+    _serialPort.write(&_txPacket[0], length);
+}
+
+void ReceiverSRXL2::sendHandshake(uint8_t destinationId)
+{
+    enum { PRIORITY = 10, INFO = 0 };
+    _txPacket[0] = SRXL2_SYNC_BYTE;
+    _txPacket[1] = PACKET_TYPE_HANDSHAKE;
+    _txPacket[2] = HANDSHAKE_PACKET_LENGTH;
+    _txPacket[3] = _deviceId;
+    _txPacket[4] = destinationId;
+    _txPacket[5] = PRIORITY;
+    _txPacket[6] = _baudSupported;
+    _txPacket[7] = INFO;
+    _txPacket[8] = static_cast<uint8_t>(_uniqueId);
+    _txPacket[9] = static_cast<uint8_t>(_uniqueId >> 8U);
+    _txPacket[10] = static_cast<uint8_t>(_uniqueId >> 16U);
+    _txPacket[11] = static_cast<uint8_t>(_uniqueId >> 24U);
+    sendPacket(HANDSHAKE_PACKET_LENGTH);
+}
+
+/*!
+Queues a telemetry payload to be sent when the receiver next polls this device.
+
+Returns false if the queue is full.
+*/
+bool ReceiverSRXL2::queueTelemetry(const telemetry_payload_t& payload)
+{
+    const uint32_t head = _telemetryQueueHead;
+    if (head - _telemetryQueueTail >= TELEMETRY_QUEUE_LENGTH) {
+        return false;
+    }
+    _telemetryQueue[head & (TELEMETRY_QUEUE_LENGTH - 1)] = payload;
+    _telemetryQueueHead = head + 1;
+    return true;
+}
+
+/*!
+Sends the next queued telemetry payload in this device's reply slot, or a NO_DATA payload if nothing is queued.
+*/
+void ReceiverSRXL2::sendTelemetry()
+{
+    _txPacket[0] = SRXL2_SYNC_BYTE;
+    _txPacket[1] = PACKET_TYPE_TELEMETRY;
+    _txPacket[2] = TELEMETRY_PACKET_LENGTH;
+    _txPacket[3] = _masterDeviceId;
+    const uint32_t tail = _telemetryQueueTail;
+    if (tail != _telemetryQueueHead) {
+        const telemetry_payload_t& payload = _telemetryQueue[tail & (TELEMETRY_QUEUE_LENGTH - 1)];
+        std::copy(payload.begin(), payload.end(), &_txPacket[4]);
+        _telemetryQueueTail = tail + 1;
+    } else {
+        std::fill(&_txPacket[4], &_txPacket[4 + TELEMETRY_PAYLOAD_SIZE], 0);
+        _txPacket[4] = TELEMETRY_SENSOR_NO_DATA;
+    }
+    sendPacket(TELEMETRY_PACKET_LENGTH);
+}
+
+/*!
+Handshake payload is source device ID, destination device ID, priority, baudrates supported, info, and 4-byte unique ID.
+
+A handshake addressed to this device is answered with this device's handshake.
+The broadcast handshake that ends the handshake phase gives the baudrate to use.
+*/
+void ReceiverSRXL2::handleHandshake()
+{
+    const uint8_t sourceId = _packet[3];
+    const uint8_t destinationId = _packet[4];
+    const uint8_t baudSupported = _packet[6];
+
+    if (destinationId == _deviceId) {
+        _masterDeviceId = sourceId;
+        sendHandshake(sourceId);
+        setState(STATE_WAITING_FOR_BROADCAST);
+    } else if (destinationId == DEVICE_ID_BROADCAST) {
+        _masterDeviceId = sourceId;
+        const uint32_t baudrate = (baudSupported & _baudSupported & BAUD_SUPPORTED_400000) ? BAUD_RATE_FAST : BAUD_RATE;
+        if (_serialPort.getBaudrate() != baudrate) {
+            _serialPort.setBaudrate(baudrate);
+        }
+        setState(STATE_RUNNING);
+    }
+}
+
+/*!
+Control payload is command, reply ID, RSSI, 2-byte frame losses, 4-byte channel mask, and then a 2-byte value for each channel set in the mask.
+
+Returns true if new channel data was received.
+*/
+bool ReceiverSRXL2::handleControl()
+{
+    const uint8_t command = _packet[3];
+    const uint8_t replyId = _packet[4];
+    bool ret = false;
+
+    if (command == CONTROL_COMMAND_CHANNEL || command == CONTROL_COMMAND_FAILSAFE) {
+        _rssi = static_cast<int8_t>(_packet[5]);
+        _frameLosses = static_cast<uint16_t>(_packet[6] | (_packet[7] << 8U));
+        const uint32_t channelMask = _packet[8] | (_packet[9] << 8U) | (_packet[10] << 16U) | (static_cast<uint32_t>(_packet[11]) << 24U);
+        const size_t endOfChannels = _packet[2] - 2U;
+        size_t offset = 12;
+        for (size_t ii = 0; ii < CHANNEL_COUNT && offset + 2 <= endOfChannels; ++ii) {
+            if (channelMask & (1U << ii)) {
+                _channels[ii] = static_cast<uint16_t>(_packet[offset] | (_packet[offset + 1] << 8U));
+                offset += 2;
+            }
+        }
+        _failsafe = (command == CONTROL_COMMAND_FAILSAFE);
+        ret = !_failsafe;
+    }
+
+    // reply in our telemetry slot, if the receiver has asked for it
+    if (replyId == _deviceId) {
+        sendTelemetry();
+    }
+    return ret;
+}
+
+/*!
+If the packet is valid then handle it and set the packet to empty.
+
+Returns true if a valid channel data packet received, false otherwise.
+*/
+bool ReceiverSRXL2::unpackPacket()
+{
+    const size_t length = _packet[2];
+    const uint16_t receivedCRC = static_cast<uint16_t>((_packet[length - 2] << 8U) | _packet[length - 1]);
+    if (calculateCRC(&_packet[0], length - 2) != receivedCRC) {
+        onCrcError();
+        _packetIsEmpty = true;
+        return false;
+    }
+    _validPacketTimeUs = timeUs();
+
+    bool ret = false;
+    switch (_packet[1]) {
+    case PACKET_TYPE_HANDSHAKE:
+        handleHandshake();
+        break;
+    case PACKET_TYPE_CONTROL:
+        ret = handleControl();
+        break;
+    default:
+        break;
+    }
+
+    // packets have side effects (replies and baudrate changes), so they must not be handled twice
+    _packetIsEmpty = true;
+    return ret;
+}
+
+/*!
+If no valid packet has been received for CONNECTION_TIMEOUT_US, then revert to 115200 baud and wait for the receiver to restart the handshake.
+*/
+void ReceiverSRXL2::checkConnectionTimeout()
+{
+    if (_state == STATE_WAITING_FOR_HANDSHAKE) {
+        return;
+    }
+    if (timeUs() - _validPacketTimeUs > CONNECTION_TIMEOUT_US) {
+        if (_serialPort.getBaudrate() != BAUD_RATE) {
+            _serialPort.setBaudrate(BAUD_RATE);
+        }
+        setState(STATE_WAITING_FOR_HANDSHAKE);
+    }
+}
+
+int32_t ReceiverSRXL2::WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait)
+{
+    const int32_t ret = ReceiverSerial::WAIT_FOR_DATA_RECEIVED(ticksToWait);
+    if (ret == 0) {
+        checkConnectionTimeout();
+    }
+    return ret;
+}
+
+bool ReceiverSRXL2::update(uint32_t tickCountDelta)
+{
+    const bool ret = ReceiverSerial::update(tickCountDelta);
+    checkConnectionTimeout();
+    return ret;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+Spektrum SRXL2 receiver protocol.
+
+SRXL2 is a bidirectional half-duplex protocol. The receiver is the bus master: it starts a handshake with each device,
+and then broadcasts a handshake giving the agreed baudrate, which is 115200 or 400000.
+After the handshake the receiver sends channel data, and a device replies with a telemetry packet when the channel data packet names it in its reply ID.
+
+Packets are
+    1 sync byte (has value 0xA6)
+    1 packet type byte
+    1 length byte, the length of the whole packet including the CRC
+    payload
+    2 CRC bytes, CRC16-CCITT over all the preceding bytes, most significant byte first
+*/
+class ReceiverSRXL2 : public ReceiverSerial {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 32;
+    enum { BAUD_RATE = 115200, BAUD_RATE_FAST = 400000 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1
+    enum { TIME_NEEDED_PER_FRAME_US = 8000 }; // maximum size packet at 115200 baud
+    enum { CONNECTION_TIMEOUT_US = 50000 }; // revert to 115200 baud and wait for handshake if no valid packet in this time
+
+    enum { SRXL2_SYNC_BYTE = 0xA6 };
+    enum packet_type_e {
+        PACKET_TYPE_HANDSHAKE = 0x21,
+        PACKET_TYPE_BIND_INFO = 0x41,
+        PACKET_TYPE_PARAMETER_CONFIG = 0x50,
+        PACKET_TYPE_SIGNAL_QUALITY = 0x55,
+        PACKET_TYPE_TELEMETRY = 0x80,
+        PACKET_TYPE_CONTROL = 0xCD
+    };
+    enum { CONTROL_COMMAND_CHANNEL = 0x00, CONTROL_COMMAND_FAILSAFE = 0x01, CONTROL_COMMAND_VTX = 0x02 };
+    enum { DEVICE_ID_RECEIVER = 0x21, DEVICE_ID_FLIGHT_CONTROLLER = 0x30, DEVICE_ID_BROADCAST = 0xFF };
+    enum { BAUD_SUPPORTED_115200 = 0x00, BAUD_SUPPORTED_400000 = 0x01 };
+    enum { HANDSHAKE_PACKET_LENGTH = 14, TELEMETRY_PACKET_LENGTH = 22, TELEMETRY_PAYLOAD_SIZE = 16 };
+    enum { TELEMETRY_SENSOR_NO_DATA = 0x00 };
+    enum { MIN_PACKET_LENGTH = 5, MAX_PACKET_LENGTH = 80 };
+
+    enum state_e { STATE_WAITING_FOR_HANDSHAKE, STATE_WAITING_FOR_BROADCAST, STATE_RUNNING };
+    enum { TELEMETRY_QUEUE_LENGTH = 4 }; // must be a power of 2
+    typedef std::array<uint8_t, TELEMETRY_PAYLOAD_SIZE> telemetry_payload_t;
+public:
+    explicit ReceiverSRXL2(SerialPort& serialPort);
+private:
+    // ReceiverSRXL2 is not copyable or moveable
+    ReceiverSRXL2(const ReceiverSRXL2&) = delete;
+    ReceiverSRXL2& operator=(const ReceiverSRXL2&) = delete;
+    ReceiverSRXL2(ReceiverSRXL2&&) = delete;
+    ReceiverSRXL2& operator=(ReceiverSRXL2&&) = delete;
+public:
+    virtual int32_t WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) override;
+    virtual bool update(uint32_t tickCountDelta) override;
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    static uint16_t calculateCRC(const uint8_t* data, size_t length);
+    void setUniqueId(uint32_t uniqueId) { _uniqueId = uniqueId; }
+    void setBaudSupported(uint8_t baudSupported) { _baudSupported = baudSupported; }
+    bool queueTelemetry(const telemetry_payload_t& payload);
+    void checkConnectionTimeout();
+// for testing
+    state_e getState() const { return _state; }
+    uint8_t getMasterDeviceId() const { return _masterDeviceId; }
+    int8_t getRSSI() const { return _rssi; }
+    uint16_t getFrameLosses() const { return _frameLosses; }
+    bool isFailsafe() const { return _failsafe; }
+    const std::array<uint8_t, MAX_PACKET_LENGTH>& getTxPacket() const { return _txPacket; }
+private:
+    void handleHandshake();
+    bool handleControl();
+    void sendHandshake(uint8_t destinationId);
+    void sendTelemetry();
+    void sendPacket(size_t length);
+    void setState(state_e state);
+private:
+    std::array<uint8_t, MAX_PACKET_LENGTH> _packetISR {};
+    std::array<uint8_t, MAX_PACKET_LENGTH> _packet {};
+    std::array<uint8_t, MAX_PACKET_LENGTH> _txPacket {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {};
+    size_t _packetLength {};
+    state_e _state {STATE_WAITING_FOR_HANDSHAKE};
+    uint8_t _deviceId {DEVICE_ID_FLIGHT_CONTROLLER};
+    uint8_t _masterDeviceId {};
+    uint8_t _baudSupported {BAUD_SUPPORTED_400000};
+    uint8_t _failsafe {false};
+    int8_t _rssi {};
+    uint16_t _frameLosses {};
+    uint32_t _uniqueId {};
+    timeUs32_t _validPacketTimeUs {};
+    // single producer (queueTelemetry), single consumer (sendTelemetry)
+    std::array<telemetry_payload_t, TELEMETRY_QUEUE_LENGTH> _telemetryQueue {};
+    volatile uint32_t _telemetryQueueHead {};
+    volatile uint32_t _telemetryQueueTail {};
+};
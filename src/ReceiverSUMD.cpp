@@ -0,0 +1,114 @@
+#include "ReceiverCRC.h"
+#include "ReceiverSUMD.h"
+
+
+ReceiverSUMD::ReceiverSUMD(SerialPort& serialPort) :
+    ReceiverSerial(serialPort)
+{
+    _auxiliaryChannelCount = CHANNEL_COUNT - STICK_COUNT;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverSUMD::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(getChannelPWM(THROTTLE)) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(getChannelPWM(ROLL)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(getChannelPWM(PITCH)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(getChannelPWM(YAW)) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+uint16_t ReceiverSUMD::getChannelPWM(size_t index) const
+{
+    if (index >= CHANNEL_COUNT) {
+        return CHANNEL_LOW;
+    }
+    return static_cast<uint16_t>(_channels[index] >> 3U);
+}
+
+uint16_t ReceiverSUMD::calculateCRC(const uint8_t* data, size_t length)
+{
+    return crc16_CCITT(0, data, length);
+}
+
+/*!
+Called from within ReceiverSerial ISR.
+
+The CRC is accumulated as each byte arrives, so the check costs one table lookup per byte and frames with a bad CRC are never passed on for unpacking.
+*/
+bool ReceiverSUMD::onDataReceivedFromISR(uint8_t data)
+{
+    const timeUs32_t timeNowUs = timeUs();
+    if (timeNowUs > _startTime + TIME_NEEDED_PER_FRAME_US) { // cppcheck-suppress unsignedLessThanZero
+        onFrameTimeout();
+    }
+
+    if (_packetIndex == 0) {
+        if (data != SUMD_HEADER_BYTE) {
+            onBadSyncByte();
+            return false;
+        }
+        _startTime = timeNowUs;
+        _crcISR = 0;
+    } else if (_packetIndex == 1) {
+        if (data != STATUS_LIVE && data != STATUS_FAILSAFE) {
+            onBadSyncByte();
+            return false;
+        }
+    } else if (_packetIndex == 2) {
+        if (data == 0 || data > MAX_FRAME_CHANNEL_COUNT) {
+            onBadSyncByte();
+            return false;
+        }
+        _frameSize = HEADER_SIZE + 2*static_cast<size_t>(data) + CRC_SIZE;
+    }
+
+    _packetISR[_packetIndex++] = data;
+    if (_packetIndex <= 2 || _packetIndex <= _frameSize - CRC_SIZE) {
+        _crcISR = crc16_CCITT(_crcISR, data);
+        return false;
+    }
+
+    if (_packetIndex == _frameSize) {
+        _packetIndex = 0;
+        const uint16_t receivedCRC = static_cast<uint16_t>((_packetISR[_frameSize - 2] << 8U) | _packetISR[_frameSize - 1]);
+        if (receivedCRC != _crcISR) {
+            onCrcError();
+            return false;
+        }
+        _packet = _packetISR;
+        _packetIsEmpty = false;
+        onFrameComplete();
+        return true;
+    }
+    return false;
+}
+
+/*!
+Unpack the packet into the member data and set the packet to empty. The CRC has already been checked in the ISR.
+
+Returns true if a valid live packet received, false otherwise.
+*/
+bool ReceiverSUMD::unpackPacket()
+{
+    _packetIsEmpty = true;
+
+    _frameChannelCount = _packet[2];
+    _failsafe = (_packet[1] == STATUS_FAILSAFE);
+    if (_failsafe) {
+        // channel values are the receiver's failsafe values, so let the cockpit failsafe handle it
+        return false;
+    }
+
+    // SUMD channel order is set in the transmitter, Graupner defaults to TAER (Throttle, Ailerons, Elevator, Rudder), so map onto AETR
+    static constexpr std::array<uint8_t, STICK_COUNT> TAER_TO_AETR = { THROTTLE, ROLL, PITCH, YAW };
+
+    const size_t channelCount = _frameChannelCount < CHANNEL_COUNT ? _frameChannelCount : CHANNEL_COUNT;
+    const uint8_t* channelData = &_packet[HEADER_SIZE];
+    for (size_t ii = 0; ii < channelCount; ++ii) {
+        const size_t index = (ii < STICK_COUNT && _channelOrder == CHANNEL_ORDER_TAER) ? TAER_TO_AETR[ii] : ii;
+        _channels[index] = static_cast<uint16_t>((channelData[2*ii] << 8U) | channelData[2*ii + 1]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return true;
+}
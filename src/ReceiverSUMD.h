@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ReceiverSerial.h"
+
+
+/*!
+Graupner SUMD receiver protocol.
+
+Frames are
+    1 header byte (has value 0xA8)
+    1 status byte (0x01 for live frames, 0x81 for failsafe frames)
+    1 channel count byte, the number of channels in the frame (up to 32)
+    2 bytes per channel, big-endian in units of 1/8 microsecond
+    2 CRC bytes, CRC16-CCITT over all the preceding bytes, most significant byte first
+
+The number of channels stored is set at compile time by RECEIVER_SUMD_CHANNEL_COUNT, any further channels in a frame are ignored.
+
+The first four channels are mapped onto AETR. Graupner transmitters default to TAER, use setChannelOrder() if the transmitter is set to AETR.
+*/
+class ReceiverSUMD : public ReceiverSerial {
+public:
+#if defined(RECEIVER_SUMD_CHANNEL_COUNT)
+    static constexpr uint32_t CHANNEL_COUNT = RECEIVER_SUMD_CHANNEL_COUNT;
+#else
+    static constexpr uint32_t CHANNEL_COUNT = 16;
+#endif
+    enum { MAX_FRAME_CHANNEL_COUNT = 32 };
+    static_assert(CHANNEL_COUNT >= STICK_COUNT && CHANNEL_COUNT <= MAX_FRAME_CHANNEL_COUNT);
+    enum { BAUD_RATE = 115200 };
+    enum { DATA_BITS = 8, PARITY = SerialPort::PARITY_NONE, STOP_BITS = 1 }; // 8N1
+    enum { TIME_NEEDED_PER_FRAME_US = 7000 }; // 69 byte frame at 115200 baud, with margin
+
+    enum { SUMD_HEADER_BYTE = 0xA8 };
+    enum { STATUS_LIVE = 0x01, STATUS_FAILSAFE = 0x81 };
+    enum { HEADER_SIZE = 3, CRC_SIZE = 2 };
+    enum { MAX_FRAME_SIZE = HEADER_SIZE + 2*MAX_FRAME_CHANNEL_COUNT + CRC_SIZE };
+    enum channel_order_e { CHANNEL_ORDER_TAER, CHANNEL_ORDER_AETR };
+public:
+    explicit ReceiverSUMD(SerialPort& serialPort);
+private:
+    // ReceiverSUMD is not copyable or moveable
+    ReceiverSUMD(const ReceiverSUMD&) = delete;
+    ReceiverSUMD& operator=(const ReceiverSUMD&) = delete;
+    ReceiverSUMD(ReceiverSUMD&&) = delete;
+    ReceiverSUMD& operator=(ReceiverSUMD&&) = delete;
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    virtual bool unpackPacket() override;
+    static uint16_t calculateCRC(const uint8_t* data, size_t length);
+    bool isFailsafe() const { return _failsafe; }
+    uint8_t getFrameChannelCount() const { return _frameChannelCount; } //!< number of channels in the most recent frame
+    void setChannelOrder(channel_order_e channelOrder) { _channelOrder = channelOrder; }
+    channel_order_e getChannelOrder() const { return _channelOrder; }
+private:
+    std::array<uint8_t, MAX_FRAME_SIZE> _packetISR {};
+    std::array<uint8_t, MAX_FRAME_SIZE> _packet {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {}; //!< channel values in units of 1/8 microsecond
+    size_t _frameSize {};
+    uint16_t _crcISR {}; //!< CRC accumulated as bytes are received
+    uint8_t _frameChannelCount {};
+    channel_order_e _channelOrder {CHANNEL_ORDER_TAER};
+    uint8_t _failsafe {false};
+};
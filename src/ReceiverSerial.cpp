@@ -1,4 +1,6 @@
+#include "ReceiverProbe.h"
 #include "ReceiverSerial.h"
+#include "ReceiverTrace.h"
 
 
 ReceiverSerialPortWatcher::ReceiverSerialPortWatcher(ReceiverBase& receiver) :
@@ -8,7 +10,12 @@ ReceiverSerialPortWatcher::ReceiverSerialPortWatcher(ReceiverBase& receiver) :
 
 bool ReceiverSerialPortWatcher::onDataReceivedFromISR(uint8_t data)
 {
-    return _receiver.onDataReceivedFromISR(data);
+    RECEIVER_PROBE(ON_DATA_RECEIVED);
+    if (_receiver.onDataReceivedFromISR(data)) {
+        RECEIVER_TRACE(FRAME_COMPLETE, 0);
+        return true;
+    }
+    return false;
 }
 
 
@@ -26,10 +33,54 @@ void ReceiverSerial::init()
 
 /*!
 This waits for data from the serial UART
+
+In deferred mode, the UART ISR signals when it has received bytes, and the bytes are parsed here.
+Returns 1 if a packet was completed, 0 otherwise, so a burst that does not complete a packet is treated in the same way as a timeout.
 */
 int32_t ReceiverSerial::WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait)
 {
-    return _serialPort.WAIT_DATA_READY(ticksToWait);
+    if (!_serialPort.isDeferred()) {
+        return _serialPort.WAIT_DATA_READY(ticksToWait);
+    }
+    // bytes left from the previous wait may already hold a complete packet
+    if (parseDeferredData()) {
+        return 1;
+    }
+    if (_serialPort.WAIT_DATA_READY(ticksToWait) == 0) {
+        return 0;
+    }
+    return parseDeferredData() ? 1 : 0;
+}
+
+/*!
+Parses the bytes in the SerialPort's deferred ring, stopping once a packet is complete, so the packet is not overwritten before it is unpacked.
+
+Returns true if a packet was completed.
+*/
+bool ReceiverSerial::parseDeferredData()
+{
+    while (_serialPort.isDataAvailable()) {
+        const uint8_t data = _serialPort.readByte();
+        RECEIVER_PROBE(ON_DATA_RECEIVED);
+        if (onDataReceivedFromISR(data)) {
+            RECEIVER_TRACE(FRAME_COMPLETE, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+Returns the parser's error statistics, together with the UART error counts from the SerialPort.
+*/
+ReceiverBase::error_statistics_t ReceiverSerial::getErrorStatistics() const
+{
+    error_statistics_t errorStatistics = _errorStatistics;
+    const SerialPort::uart_error_counts_t& uartErrorCounts = _serialPort.getErrorCounts();
+    errorStatistics.uartOverrunCount = uartErrorCounts.overrunCount;
+    errorStatistics.uartFramingErrorCount = uartErrorCounts.framingErrorCount;
+    errorStatistics.uartParityErrorCount = uartErrorCounts.parityErrorCount;
+    return errorStatistics;
 }
 
 bool ReceiverSerial::isDataAvailable() const
@@ -56,7 +107,12 @@ bool ReceiverSerial::update(uint32_t tickCountDelta)
         return false;
     }
 
-    if (!unpackPacket()) {
+    bool unpacked {};
+    {
+        RECEIVER_PROBE(UNPACK_PACKET);
+        unpacked = unpackPacket();
+    }
+    if (!unpacked) {
         return false;
     }
 
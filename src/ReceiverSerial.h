@@ -2,6 +2,7 @@
 
 #include "SerialPort.h"
 #include "ReceiverBase.h"
+#include "ReceiverTrace.h"
 
 
 class ReceiverSerialPortWatcher : public SerialPortWatcherBase {
@@ -14,6 +15,12 @@ private:
 };
 
 
+/*!
+Receiver connected by a SerialPort.
+
+If the SerialPort is in deferred mode, the bytes are parsed in WAIT_FOR_DATA_RECEIVED() (or by the ReceiverTask in time based scheduling),
+that is in the receiver task, rather than in the UART ISR.
+*/
 class ReceiverSerial : public ReceiverBase {
 public:
     explicit ReceiverSerial(SerialPort& serialPort);
@@ -29,15 +36,50 @@ public:
     virtual bool isDataAvailable() const override;
     virtual uint8_t readByte() override;
     virtual bool update(uint32_t tickCountDelta) override;
+    virtual error_statistics_t getErrorStatistics() const override;
     bool isPacketEmpty() const { return _packetIsEmpty; }
     void setPacketEmpty() { _packetIsEmpty = true; }
     size_t getPacketIndex() const { return _packetIndex; } // for testing
+protected:
+    bool parseDeferredData();
+    // error accounting for the protocol parsers, these may be called from the UART ISR
+    //! called when the inter-byte timeout has expired, only a partially received frame is counted as dropped, not an idle gap between frames
+    void onFrameTimeout() {
+        onFrameTimeout(_packetIndex);
+        _packetIndex = 0;
+    }
+    //! for parsers where _packetIndex is not the number of bytes received in the frame so far
+    void onFrameTimeout(size_t frameByteCount) {
+        if (frameByteCount > 0) {
+            ++_droppedPacketCount;
+            ++_errorStatistics.truncatedFrameCount;
+            _errorStatistics.discardedByteCount += static_cast<uint32_t>(frameByteCount);
+        }
+    }
+    //! called when a byte is not a valid sync or header byte, the bytes of the frame so far, and the bad byte, are discarded
+    void onBadSyncByte() {
+        ++_errorStatistics.badSyncByteCount;
+        _errorStatistics.discardedByteCount += static_cast<uint32_t>(_packetIndex) + 1;
+        _packetIndex = 0;
+        _syncLost = true;
+    }
+    //! called when a frame is complete, counts a resync if sync had been lost
+    void onFrameComplete() {
+        if (_syncLost) {
+            _syncLost = false;
+            ++_errorStatistics.resyncCount;
+        }
+    }
+    void onCrcError() {
+        ++_errorStatistics.crcErrorCount;
+        RECEIVER_TRACE(CRC_FAILURE, 0);
+    }
 protected:
     SerialPort& _serialPort;
     ReceiverSerialPortWatcher _serialPortWatcher;
     bool _packetIsEmpty {true};
     uint32_t _receivedPacketCount {};
-    int32_t _errorPacketCount {};
     size_t _packetIndex {};
     timeUs32_t _startTime {};
+    bool _syncLost {false};
 };
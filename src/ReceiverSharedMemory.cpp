@@ -0,0 +1,149 @@
+#if defined(__linux__)
+
+#include "ReceiverSharedMemory.h"
+
+#include <TimeMicroseconds.h>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+ReceiverSharedMemoryExporter::ReceiverSharedMemoryExporter(const char* name) :
+    _name(name)
+{
+}
+
+ReceiverSharedMemoryExporter::~ReceiverSharedMemoryExporter()
+{
+    if (_region != nullptr) {
+        munmap(_region, sizeof(receiver_shared_memory_region_t));
+        shm_unlink(_name);
+    }
+}
+
+/*!
+Creates the shared memory region, replacing any region of the same name left over from a previous run.
+
+Returns false on failure.
+*/
+bool ReceiverSharedMemoryExporter::init()
+{
+    shm_unlink(_name);
+    const int fd = shm_open(_name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, sizeof(receiver_shared_memory_region_t)) != 0) {
+        close(fd);
+        shm_unlink(_name);
+        return false;
+    }
+    void* ptr = mmap(nullptr, sizeof(receiver_shared_memory_region_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
+        shm_unlink(_name);
+        return false;
+    }
+    _region = new (ptr) receiver_shared_memory_region_t {};
+    _region->version = receiver_shared_memory_region_t::VERSION;
+    _region->snapshotSize = sizeof(receiver_snapshot_t);
+    // magic is written last, so a reader that sees it also sees a fully initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    _region->magic = receiver_shared_memory_region_t::MAGIC;
+    return true;
+}
+
+void ReceiverSharedMemoryExporter::publish(const ReceiverBase& receiver)
+{
+    makeReceiverSnapshot(_snapshot, receiver, _publishCount + 1, timeUs());
+    publish(_snapshot);
+}
+
+/*!
+Publishes the snapshot. The snapshot sequence number is replaced by this exporter's publish count.
+*/
+void ReceiverSharedMemoryExporter::publish(const receiver_snapshot_t& snapshot)
+{
+    if (_region == nullptr) {
+        return;
+    }
+    ++_publishCount;
+    // single writer, so sequence can be updated with plain load and store
+    const uint32_t sequence = _region->sequence.load(std::memory_order_relaxed);
+    _region->sequence.store(sequence + 1, std::memory_order_relaxed); // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&_region->snapshot, &snapshot, sizeof(receiver_snapshot_t));
+    _region->snapshot.sequence = _publishCount;
+    _region->sequence.store(_publishCount << 1U, std::memory_order_release); // even: write complete
+}
+
+
+ReceiverSharedMemoryReader::ReceiverSharedMemoryReader(const char* name) :
+    _name(name)
+{
+}
+
+ReceiverSharedMemoryReader::~ReceiverSharedMemoryReader()
+{
+    if (_region != nullptr) {
+        munmap(const_cast<receiver_shared_memory_region_t*>(_region), sizeof(receiver_shared_memory_region_t)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+}
+
+/*!
+Maps the shared memory region read-only.
+
+Returns false if the region does not exist, or was created by an incompatible exporter. In that case init() may be retried later.
+*/
+bool ReceiverSharedMemoryReader::init()
+{
+    const int fd = shm_open(_name, O_RDONLY | O_CLOEXEC, 0); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    if (fd < 0) {
+        return false;
+    }
+    void* ptr = mmap(nullptr, sizeof(receiver_shared_memory_region_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
+        return false;
+    }
+    const auto* region = static_cast<const receiver_shared_memory_region_t*>(ptr);
+    const bool valid = region->magic == receiver_shared_memory_region_t::MAGIC;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!valid || region->version != receiver_shared_memory_region_t::VERSION || region->snapshotSize != sizeof(receiver_snapshot_t)) {
+        munmap(ptr, sizeof(receiver_shared_memory_region_t));
+        return false;
+    }
+    _region = region;
+    return true;
+}
+
+/*!
+Copies the latest snapshot. Retries if the writer was publishing during the copy.
+
+Returns false if nothing has been published yet, or if a consistent copy could not be made in MAX_READ_ATTEMPTS attempts.
+*/
+bool ReceiverSharedMemoryReader::read(receiver_snapshot_t& snapshot) const
+{
+    if (_region == nullptr) {
+        return false;
+    }
+    for (size_t ii = 0; ii < MAX_READ_ATTEMPTS; ++ii) {
+        const uint32_t sequenceBefore = _region->sequence.load(std::memory_order_acquire);
+        if (sequenceBefore == 0) {
+            return false;
+        }
+        if ((sequenceBefore & 1U) == 0) {
+            memcpy(&snapshot, &_region->snapshot, sizeof(receiver_snapshot_t));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_region->sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+                return true;
+            }
+        }
+        ++_retryCount;
+    }
+    return false;
+}
+
+#endif // __linux__
@@ -0,0 +1,85 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include "ReceiverSnapshot.h"
+
+#include <atomic>
+
+
+/*!
+Layout of the POSIX shared memory region used to publish receiver snapshots to other processes.
+
+The snapshot is protected by a sequence lock: the writer makes `sequence` odd while it is writing and even when it has finished,
+so readers never block the writer and readers detect, and retry, a torn read.
+*/
+struct receiver_shared_memory_region_t {
+    static constexpr uint32_t MAGIC = 0x52435348; // "HSCR" little-endian
+    enum { VERSION = 2 };
+    uint32_t magic;
+    uint32_t version;
+    uint32_t snapshotSize; //!< sizeof(receiver_snapshot_t), so readers built against a different layout are rejected
+    alignas(64) std::atomic<uint32_t> sequence; // on its own cache line, since it is written on every publish
+    receiver_snapshot_t snapshot;
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "seqlock requires lock free atomics in shared memory");
+
+
+/*!
+Publishes receiver snapshots into a named POSIX shared memory region.
+
+There must be only one exporter per region. publish() makes no system calls, so it may be called from the receiver task.
+*/
+class ReceiverSharedMemoryExporter {
+public:
+    explicit ReceiverSharedMemoryExporter(const char* name);
+    ~ReceiverSharedMemoryExporter();
+    bool init();
+private:
+    // ReceiverSharedMemoryExporter is not copyable or moveable
+    ReceiverSharedMemoryExporter(const ReceiverSharedMemoryExporter&) = delete;
+    ReceiverSharedMemoryExporter& operator=(const ReceiverSharedMemoryExporter&) = delete;
+    ReceiverSharedMemoryExporter(ReceiverSharedMemoryExporter&&) = delete;
+    ReceiverSharedMemoryExporter& operator=(ReceiverSharedMemoryExporter&&) = delete;
+public:
+    void publish(const ReceiverBase& receiver);
+    void publish(const receiver_snapshot_t& snapshot);
+    uint32_t getPublishCount() const { return _publishCount; }
+private:
+    const char* _name;
+    receiver_shared_memory_region_t* _region {nullptr};
+    uint32_t _publishCount {};
+    receiver_snapshot_t _snapshot {};
+};
+
+
+/*!
+Reads receiver snapshots from a shared memory region created by a ReceiverSharedMemoryExporter.
+
+The region is mapped read-only, and reading makes no system calls. Any number of readers, in any number of processes, may read concurrently.
+*/
+class ReceiverSharedMemoryReader {
+public:
+    enum { MAX_READ_ATTEMPTS = 64 };
+public:
+    explicit ReceiverSharedMemoryReader(const char* name);
+    ~ReceiverSharedMemoryReader();
+    bool init();
+private:
+    // ReceiverSharedMemoryReader is not copyable or moveable
+    ReceiverSharedMemoryReader(const ReceiverSharedMemoryReader&) = delete;
+    ReceiverSharedMemoryReader& operator=(const ReceiverSharedMemoryReader&) = delete;
+    ReceiverSharedMemoryReader(ReceiverSharedMemoryReader&&) = delete;
+    ReceiverSharedMemoryReader& operator=(ReceiverSharedMemoryReader&&) = delete;
+public:
+    bool read(receiver_snapshot_t& snapshot) const;
+    //! the snapshot sequence number, cheap to poll to find out if there is a new snapshot without copying it
+    uint32_t getSequence() const { return _region->sequence.load(std::memory_order_acquire) >> 1U; }
+    uint32_t getRetryCount() const { return _retryCount; }
+private:
+    const char* _name;
+    const receiver_shared_memory_region_t* _region {nullptr};
+    mutable uint32_t _retryCount {};
+};
+
+#endif // __linux__
@@ -0,0 +1,27 @@
+#include "ReceiverSnapshot.h"
+
+#include <algorithm>
+
+
+/*!
+Fills the snapshot from the receiver's current state.
+*/
+void makeReceiverSnapshot(receiver_snapshot_t& snapshot, const ReceiverBase& receiver, uint32_t sequence, uint32_t timeUs)
+{
+    snapshot.sequence = sequence;
+    snapshot.timeUs = timeUs;
+    snapshot.controls = receiver.getControls();
+    snapshot.switches = receiver.getSwitches();
+
+    const uint32_t channelCount = std::min(static_cast<uint32_t>(receiver_snapshot_t::CHANNEL_COUNT), ReceiverBase::STICK_COUNT + receiver.getAuxiliaryChannelCount());
+    snapshot.channelCount = channelCount;
+    for (size_t ii = 0; ii < receiver_snapshot_t::CHANNEL_COUNT; ++ii) {
+        snapshot.channels[ii] = ii < channelCount ? receiver.getChannelPWM(ii) : 0;
+    }
+
+    snapshot.packetCount = receiver.getPacketCount();
+    snapshot.droppedPacketCount = receiver.getDroppedPacketCount();
+    snapshot.droppedPacketCountDelta = receiver.getDroppedPacketCountDelta();
+    snapshot.tickCountDelta = receiver.getTickCountDelta();
+    snapshot.errorStatistics = receiver.getErrorStatistics();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ReceiverBase.h"
+
+#include <array>
+
+
+/*!
+Snapshot of the receiver state, for consumers that do not have access to the receiver object itself,
+for example other processes reading the state from shared memory.
+
+The snapshot is plain data with a fixed layout, so it may be copied with memcpy.
+*/
+struct receiver_snapshot_t {
+    enum { CHANNEL_COUNT = 18 };
+    uint32_t sequence; //!< incremented each time a snapshot is published
+    uint32_t timeUs; //!< time the snapshot was taken
+    ReceiverBase::controls_t controls;
+    uint32_t switches;
+    uint32_t channelCount; //!< number of valid entries in channels
+    std::array<uint16_t, CHANNEL_COUNT> channels; //!< channels in PWM range
+    // link statistics
+    int32_t packetCount;
+    int32_t droppedPacketCount;
+    int32_t droppedPacketCountDelta;
+    uint32_t tickCountDelta;
+    ReceiverBase::error_statistics_t errorStatistics;
+};
+
+void makeReceiverSnapshot(receiver_snapshot_t& snapshot, const ReceiverBase& receiver, uint32_t sequence, uint32_t timeUs); // NOLINT(readability-avoid-const-params-in-decls) false positive
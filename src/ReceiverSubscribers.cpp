@@ -0,0 +1,128 @@
+#include "ReceiverSubscribers.h"
+
+#include <TimeMicroseconds.h>
+#include <cstring>
+
+
+/*!
+Claims a free slot for a new subscriber. The subscriber sees only snapshots published after it subscribed.
+
+Returns a handle for use with read(), or NO_SUBSCRIBER if all slots are in use.
+*/
+int32_t ReceiverSubscribers::subscribe(ReceiverWatcher* watcher)
+{
+    for (size_t ii = 0; ii < MAX_SUBSCRIBER_COUNT; ++ii) {
+        slot_t& slot = _slots[ii];
+        uint32_t expected = SLOT_FREE;
+        if (slot.state.compare_exchange_strong(expected, SLOT_CLAIMED, std::memory_order_acquire)) {
+            slot.readSequence.store(slot.publishedSequence.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            slot.missedCount.store(0, std::memory_order_relaxed);
+            slot.watcher.store(watcher, std::memory_order_relaxed);
+            // publisher only uses the slot once it is active, so it sees the initialized fields
+            slot.state.store(SLOT_ACTIVE, std::memory_order_release);
+            return static_cast<int32_t>(ii);
+        }
+    }
+    return NO_SUBSCRIBER;
+}
+
+void ReceiverSubscribers::unsubscribe(int32_t handle)
+{
+    if (handle < 0 || handle >= MAX_SUBSCRIBER_COUNT) {
+        return;
+    }
+    slot_t& slot = _slots[static_cast<size_t>(handle)];
+    slot.watcher.store(nullptr, std::memory_order_relaxed);
+    slot.state.store(SLOT_FREE, std::memory_order_release);
+}
+
+size_t ReceiverSubscribers::getSubscriberCount() const
+{
+    size_t count = 0;
+    for (const slot_t& slot : _slots) {
+        if (slot.state.load(std::memory_order_relaxed) == SLOT_ACTIVE) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void ReceiverSubscribers::publish(const ReceiverBase& receiver)
+{
+    makeReceiverSnapshot(_snapshot, receiver, _publishCount + 1, timeUs());
+    publish(_snapshot);
+}
+
+/*!
+Copies the snapshot into the slot of each subscriber, and then calls each subscriber's watcher.
+
+There must be only one publisher. The snapshot sequence number is replaced by the publish count.
+*/
+void ReceiverSubscribers::publish(const receiver_snapshot_t& snapshot)
+{
+    ++_publishCount;
+    for (slot_t& slot : _slots) {
+        if (slot.state.load(std::memory_order_acquire) != SLOT_ACTIVE) {
+            continue;
+        }
+        const uint32_t publishedSequence = slot.publishedSequence.load(std::memory_order_relaxed);
+        if (publishedSequence != slot.readSequence.load(std::memory_order_relaxed)) {
+            // previous snapshot was not read before being overwritten
+            slot.missedCount.store(slot.missedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        // single writer, so sequence can be updated with plain load and store
+        const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&slot.snapshot, &snapshot, sizeof(receiver_snapshot_t));
+        slot.snapshot.sequence = _publishCount;
+        slot.sequence.store(sequence + 2, std::memory_order_release); // even: write complete
+        slot.publishedSequence.store(_publishCount, std::memory_order_relaxed);
+    }
+    for (const slot_t& slot : _slots) {
+        ReceiverWatcher* watcher = slot.watcher.load(std::memory_order_relaxed);
+        if (watcher != nullptr && slot.state.load(std::memory_order_relaxed) == SLOT_ACTIVE) {
+            watcher->newReceiverPacketAvailable();
+        }
+    }
+}
+
+/*!
+Copies the latest snapshot for the subscriber. Retries if the publisher was writing during the copy.
+
+Returns true if the snapshot is new, that is it was published since the subscriber last read.
+Returns false if there is no new snapshot, or if a consistent copy could not be made in MAX_READ_ATTEMPTS attempts.
+*/
+bool ReceiverSubscribers::read(int32_t handle, receiver_snapshot_t& snapshot)
+{
+    if (handle < 0 || handle >= MAX_SUBSCRIBER_COUNT) {
+        return false;
+    }
+    slot_t& slot = _slots[static_cast<size_t>(handle)];
+    for (size_t ii = 0; ii < MAX_READ_ATTEMPTS; ++ii) {
+        const uint32_t sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+        if ((sequenceBefore & 1U) == 0) {
+            memcpy(&snapshot, &slot.snapshot, sizeof(receiver_snapshot_t));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+                if (snapshot.sequence == slot.readSequence.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                slot.readSequence.store(snapshot.sequence, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*!
+Returns the number of snapshots that were overwritten before the subscriber read them.
+*/
+uint32_t ReceiverSubscribers::getMissedCount(int32_t handle) const
+{
+    if (handle < 0 || handle >= MAX_SUBSCRIBER_COUNT) {
+        return 0;
+    }
+    return _slots[static_cast<size_t>(handle)].missedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ReceiverSnapshot.h"
+
+#include <atomic>
+
+#if !defined(RECEIVER_MAX_SUBSCRIBER_COUNT)
+#define RECEIVER_MAX_SUBSCRIBER_COUNT 4
+#endif
+
+
+/*!
+Fixed capacity registry of subscribers to a receiver's snapshots, for when more than one consumer needs each new frame,
+for example the flight controller, the OSD, the blackbox logger, and the telemetry task.
+
+Each subscriber has its own slot, holding the latest snapshot, protected by a sequence lock, so publish() never blocks and never waits for subscribers.
+A subscriber that has not read the previous snapshot when a new one is published has that update counted as missed.
+Each subscriber may also have a ReceiverWatcher, which is called after each publish, for example to signal the subscriber's task.
+
+subscribe() and unsubscribe() are lock free and may be called at any time. Each handle must be read by only one task.
+*/
+class ReceiverSubscribers {
+public:
+    enum { MAX_SUBSCRIBER_COUNT = RECEIVER_MAX_SUBSCRIBER_COUNT };
+    enum { NO_SUBSCRIBER = -1 };
+    enum { MAX_READ_ATTEMPTS = 64 };
+public:
+    ReceiverSubscribers() = default;
+private:
+    // ReceiverSubscribers is not copyable or moveable
+    ReceiverSubscribers(const ReceiverSubscribers&) = delete;
+    ReceiverSubscribers& operator=(const ReceiverSubscribers&) = delete;
+    ReceiverSubscribers(ReceiverSubscribers&&) = delete;
+    ReceiverSubscribers& operator=(ReceiverSubscribers&&) = delete;
+public:
+    int32_t subscribe(ReceiverWatcher* watcher);
+    int32_t subscribe() { return subscribe(nullptr); }
+    void unsubscribe(int32_t handle);
+    size_t getSubscriberCount() const;
+
+    void publish(const ReceiverBase& receiver);
+    void publish(const receiver_snapshot_t& snapshot);
+    uint32_t getPublishCount() const { return _publishCount; }
+
+    bool read(int32_t handle, receiver_snapshot_t& snapshot);
+    uint32_t getMissedCount(int32_t handle) const;
+private:
+    enum slot_state_e : uint32_t { SLOT_FREE, SLOT_CLAIMED, SLOT_ACTIVE };
+    // each slot is on its own cache lines, so subscribers on different cores do not contend
+    struct alignas(64) slot_t {
+        std::atomic<uint32_t> state {SLOT_FREE};
+        std::atomic<uint32_t> sequence {}; //!< sequence lock, odd while the snapshot is being written
+        std::atomic<uint32_t> publishedSequence {}; //!< written by the publisher, the sequence number of the snapshot in this slot
+        std::atomic<uint32_t> readSequence {}; //!< written by the subscriber, the sequence number of the last snapshot it read
+        std::atomic<uint32_t> missedCount {};
+        std::atomic<ReceiverWatcher*> watcher {nullptr};
+        receiver_snapshot_t snapshot {};
+    };
+    std::array<slot_t, MAX_SUBSCRIBER_COUNT> _slots {};
+    uint32_t _publishCount {};
+    receiver_snapshot_t _snapshot {};
+};
@@ -1,9 +1,17 @@
 #include "CockpitBase.h"
 #include "ReceiverBase.h"
+#include "ReceiverFrameQueue.h"
+#include "ReceiverProbe.h"
+#include "ReceiverSubscribers.h"
 #include "ReceiverTask.h"
+#include "ReceiverTrace.h"
 
 #include <TimeMicroseconds.h>
 
+#if defined(RECEIVER_TASK_USE_STD_THREAD) && defined(__linux__)
+#include <ctime>
+#endif
+
 #if defined(FRAMEWORK_USE_FREERTOS)
 #if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
 #include <freertos/FreeRTOS.h>
@@ -22,7 +30,8 @@ ReceiverTask::ReceiverTask(uint32_t taskIntervalMicroseconds, ReceiverBase& rece
     TaskBase(taskIntervalMicroseconds),
     _receiver(receiver),
     _cockpit(cockpit),
-    _receiverWatcher(receiver.getReceiverWatcher())
+    _receiverWatcher(receiver.getReceiverWatcher()),
+    _framePredictor(taskIntervalMicroseconds)
 {
 }
 
@@ -31,6 +40,7 @@ loop() function for when not using FREERTOS
 */
 void ReceiverTask::loop()
 {
+    RECEIVER_PROBE(TASK_LOOP);
     // calculate _tickCountDelta to get actual deltaT value, since we may have been delayed for more than taskIntervalTicks
 #if defined(FRAMEWORK_USE_FREERTOS)
     const TickType_t tickCount = xTaskGetTickCount();
@@ -41,16 +51,42 @@ void ReceiverTask::loop()
     _tickCountDelta = tickCount - _tickCountPrevious;
     _tickCountPrevious = tickCount;
 
-    if (_receiver.update(_tickCountDelta)) {
+    bool packetReceived {};
+    {
+        RECEIVER_PROBE(UPDATE);
+        packetReceived = _receiver.update(_tickCountDelta);
+    }
+    if (packetReceived) {
         CockpitBase::controls_t controls; // NOLINT(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
         controls.tickCount = tickCount;
         _receiver.getStickValues(controls.throttleStick, controls.rollStick, controls.pitchStick, controls.yawStick);
-        _cockpit.updateControls(controls);
+        if (_frameQueue) {
+            // decoupled mode, the cockpit drains the queue on its own schedule
+            _frameQueue->push(controls, _receiver, timeUs());
+        } else {
+            _cockpit.updateControls(controls);
+        }
+        RECEIVER_TRACE(COCKPIT_UPDATE, 0);
         // if there a watcher, then let it know there is a new packet
         if (_receiverWatcher) {
             _receiverWatcher->newReceiverPacketAvailable();
         }
+        ReceiverSubscribers* receiverSubscribers = _receiver.getReceiverSubscribers();
+        if (receiverSubscribers) {
+            receiverSubscribers->publish(_receiver);
+        }
     } else {
+        checkFailsafe(tickCount);
+    }
+}
+
+/*!
+In decoupled mode failsafe is checked by the cockpit's task when it drains the frame queue, so the cockpit is not called from this task.
+*/
+void ReceiverTask::checkFailsafe(uint32_t tickCount)
+{
+    if (!_frameQueue) {
+        RECEIVER_TRACE(FAILSAFE_CHECK, 0);
         _cockpit.checkFailsafe(tickCount);
     }
 }
@@ -58,8 +94,14 @@ void ReceiverTask::loop()
 /*!
 Task function for the ReceiverTask. Sets up and runs the task loop() function.
 */
-[[noreturn]] void ReceiverTask::task()
+#if defined(FRAMEWORK_USE_FREERTOS)
+[[noreturn]]
+#endif
+void ReceiverTask::task()
 {
+#if defined(LIBRARY_RECEIVER_USE_PROBES)
+    ReceiverProbe::init();
+#endif
 #if defined(FRAMEWORK_USE_FREERTOS)
 
     // BaseType_t is int, TickType_t is uint32_t
@@ -67,15 +109,43 @@ Task function for the ReceiverTask. Sets up and runs the task loop() function.
         // event driven scheduling
         const uint32_t ticksToWait = _cockpit.getTimeoutTicks();
         while (true) {
-            if (_receiver.WAIT_FOR_DATA_RECEIVED(ticksToWait) == pdPASS) {
+            // WAIT_FOR_DATA_RECEIVED returns the number of frames received since the last wait, 0 if timeout
+            const int32_t frameCount = _receiver.WAIT_FOR_DATA_RECEIVED(ticksToWait);
+            RECEIVER_TRACE(TASK_WAKE, static_cast<uint32_t>(frameCount));
+            if (frameCount > 0) {
                 loop();
             } else {
                 // WAIT timed out, so check failsafe
-                _cockpit.checkFailsafe(xTaskGetTickCount());
+                checkFailsafe(xTaskGetTickCount());
+            }
+        }
+    } else if (_predictiveWake) {
+        _pollTimeUs = timeUs();
+        while (true) {
+            predictiveWakeLoop();
+        }
+    } else if (startPeriodicTimer()) {
+        // microsecond accurate time based scheduling, the task is notified by a periodic hardware timer
+        // the timer period is absolute, so there is no drift, and more than one notification means that loops were missed
+        // (unless only notification index 0 is available, when a data signal to this task also counts, see TaskSignal)
+        const uint32_t ticksToWait = _cockpit.getTimeoutTicks();
+        while (true) {
+            const int32_t periodCount = _periodicSignal.WAIT(ticksToWait);
+            RECEIVER_TRACE(TASK_WAKE, static_cast<uint32_t>(periodCount));
+            if (periodCount == 0) {
+                // timer has stopped, so check failsafe
+                checkFailsafe(xTaskGetTickCount());
+                continue;
+            }
+            if (periodCount > 1) {
+                _overrunCount += static_cast<uint32_t>(periodCount - 1);
+                _wasDelayed = true;
             }
+            readAvailableData();
+            loop();
         }
     } else {
-        // time based scheduling
+        // time based scheduling, rounded to whole ticks
         const uint32_t taskIntervalTicks = _taskIntervalMicroseconds < 1000 ? 1 : pdMS_TO_TICKS(_taskIntervalMicroseconds / 1000);
         _previousWakeTimeTicks = xTaskGetTickCount();
 
@@ -89,25 +159,309 @@ Task function for the ReceiverTask. Sets up and runs the task loop() function.
 #else
             vTaskDelayUntil(&_previousWakeTimeTicks, taskIntervalTicks);
 #endif
-            while (_receiver.isDataAvailable()) {
-                // Read 1 byte from UART buffer and give it to the RX protocol parser
-                if (_receiver.onDataReceivedFromISR(_receiver.readByte())) {
-                    // onDataReceived returns true once packet is complete
-                    break;
-                }
+            RECEIVER_TRACE(TASK_WAKE, 1);
+            readAvailableData();
+            loop();
+        }
+    }
+#elif defined(RECEIVER_TASK_USE_STD_THREAD)
+    if (_taskIntervalMicroseconds == 0) {
+        // event driven scheduling, ticks are milliseconds
+        const uint32_t ticksToWait = _cockpit.getTimeoutTicks();
+        while (!_stopRequested) {
+            const int32_t frameCount = _receiver.WAIT_FOR_DATA_RECEIVED(ticksToWait);
+            RECEIVER_TRACE(TASK_WAKE, static_cast<uint32_t>(frameCount));
+            if (frameCount > 0) {
+                loop();
+            } else {
+                // WAIT timed out, so check failsafe
+                checkFailsafe(timeMs());
+            }
+        }
+    } else if (_predictiveWake) {
+        _pollTimeUs = timeUs();
+        while (!_stopRequested) {
+            predictiveWakeLoop();
+        }
+    } else if (_periodicTimer == PERIODIC_TIMER_EXTERNAL) {
+        // time based scheduling, the task is notified by onPeriodicTimerFromISR()
+        const uint32_t ticksToWait = _cockpit.getTimeoutTicks();
+        while (!_stopRequested) {
+            const int32_t periodCount = _periodicSignal.WAIT(ticksToWait);
+            RECEIVER_TRACE(TASK_WAKE, static_cast<uint32_t>(periodCount));
+            if (periodCount == 0) {
+                checkFailsafe(timeMs());
+                continue;
+            }
+            if (periodCount > 1) {
+                _overrunCount += static_cast<uint32_t>(periodCount - 1);
+                _wasDelayed = true;
             }
+            readAvailableData();
             loop();
         }
+    } else {
+        // time based scheduling, with absolute deadlines so that the interval does not drift
+        enum { NANOSECONDS_PER_SECOND = 1000000000, NANOSECONDS_PER_MICROSECOND = 1000 };
+        const int64_t intervalNs = static_cast<int64_t>(_taskIntervalMicroseconds) * NANOSECONDS_PER_MICROSECOND;
+#if defined(__linux__)
+        timespec deadline {};
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        while (!_stopRequested) {
+            deadline.tv_nsec += intervalNs;
+            while (deadline.tv_nsec >= NANOSECONDS_PER_SECOND) {
+                deadline.tv_nsec -= NANOSECONDS_PER_SECOND;
+                ++deadline.tv_sec;
+            }
+            timespec now {};
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec > deadline.tv_nsec)) {
+                // deadline already passed, so restart the schedule from now rather than running several loops back to back
+                ++_overrunCount;
+                _wasDelayed = true;
+                deadline = now;
+            } else {
+                // retry if interrupted by a signal
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) != 0 && !_stopRequested) {}
+            }
+            RECEIVER_TRACE(TASK_WAKE, 1);
+            readAvailableData();
+            loop();
+        }
+#else
+        auto deadline = std::chrono::steady_clock::now();
+        while (!_stopRequested) {
+            deadline += std::chrono::nanoseconds(intervalNs);
+            const auto now = std::chrono::steady_clock::now();
+            if (now > deadline) {
+                ++_overrunCount;
+                _wasDelayed = true;
+                deadline = now;
+            } else {
+                std::this_thread::sleep_until(deadline);
+            }
+            RECEIVER_TRACE(TASK_WAKE, 1);
+            readAvailableData();
+            loop();
+        }
+#endif
     }
 #else
     while (true) {}
 #endif // FRAMEWORK_USE_FREERTOS
 }
 
+/*!
+Starts the periodic hardware timer used for microsecond accurate time based scheduling.
+
+Returns false if the RTOS tick should be used instead, that is if the task interval is a whole number of ticks or if there is no periodic timer on this platform.
+*/
+bool ReceiverTask::startPeriodicTimer()
+{
+    if (_periodicTimer == PERIODIC_TIMER_EXTERNAL) {
+        return true;
+    }
+#if defined(FRAMEWORK_USE_FREERTOS)
+    enum { MICROSECONDS_PER_SECOND = 1000000 };
+    const uint32_t tickPeriodMicroseconds = MICROSECONDS_PER_SECOND / configTICK_RATE_HZ;
+    if (_taskIntervalMicroseconds % tickPeriodMicroseconds == 0) {
+        return false;
+    }
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+    const esp_timer_create_args_t timerArgs = {
+        .callback = periodicTimerCallback,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ReceiverTask",
+        .skip_unhandled_events = false
+    };
+    if (esp_timer_create(&timerArgs, &_periodicTimerHandle) != ESP_OK) {
+        return false;
+    }
+    if (esp_timer_start_periodic(_periodicTimerHandle, _taskIntervalMicroseconds) != ESP_OK) {
+        esp_timer_delete(_periodicTimerHandle);
+        return false;
+    }
+    _periodicTimer = PERIODIC_TIMER_INTERNAL;
+    return true;
+#elif defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+    // negative delay means the interval is measured between the starts of the callbacks, so there is no drift
+    const bool started = add_repeating_timer_us(-static_cast<int64_t>(_taskIntervalMicroseconds),
+        [](repeating_timer_t* repeatingTimer) { periodicTimerCallback(repeatingTimer->user_data); return true; },
+        this, &_repeatingTimer);
+    if (started) {
+        _periodicTimer = PERIODIC_TIMER_INTERNAL;
+    }
+    return started;
+#else
+    return false;
+#endif
+#else
+    return false;
+#endif // FRAMEWORK_USE_FREERTOS
+}
+
+/*!
+Called by the periodic timer, in interrupt context on RP2040, in the esp_timer task on ESP32.
+*/
+void ReceiverTask::periodicTimerCallback(void* arg)
+{
+    auto* receiverTask = static_cast<ReceiverTask*>(arg);
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+    receiverTask->_periodicSignal.SIGNAL();
+#else
+    receiverTask->_periodicSignal.SIGNAL_FROM_ISR();
+#endif
+}
+
+/*!
+Used for time-based scheduling, reads the bytes received since the last loop and gives them to the receiver.
+
+Returns true if a packet was completed.
+*/
+bool ReceiverTask::readAvailableData()
+{
+    while (_receiver.isDataAvailable()) {
+        // Read 1 byte from UART buffer and give it to the RX protocol parser
+        const uint8_t data = _receiver.readByte();
+        RECEIVER_PROBE(ON_DATA_RECEIVED);
+        if (_receiver.onDataReceivedFromISR(data)) {
+            // onDataReceived returns true once packet is complete
+            RECEIVER_TRACE(FRAME_COMPLETE, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+Returns true if a frame has arrived, either read by polling or signalled by the receiver's ISR.
+*/
+bool ReceiverTask::pollForFrame()
+{
+    const bool packetCompleted = readAvailableData();
+    return _receiver.WAIT_FOR_DATA_RECEIVED(0) > 0 || packetCompleted;
+}
+
+/*!
+Sleeps until wakeTimeUs, returns immediately if wakeTimeUs has passed.
+
+With FreeRTOS the sleep is rounded down to whole ticks, so the task wakes early rather than late.
+*/
+void ReceiverTask::sleepUntil(timeUs32_t wakeTimeUs)
+{
+    const int32_t sleepUs = static_cast<int32_t>(wakeTimeUs - timeUs());
+    if (sleepUs <= 0) {
+        return;
+    }
+#if defined(FRAMEWORK_USE_FREERTOS)
+    enum { MICROSECONDS_PER_SECOND = 1000000 };
+    const uint32_t tickPeriodMicroseconds = MICROSECONDS_PER_SECOND / configTICK_RATE_HZ;
+    const TickType_t ticks = static_cast<uint32_t>(sleepUs) / tickPeriodMicroseconds;
+    if (ticks > 0) {
+        vTaskDelay(ticks);
+    }
+#elif defined(RECEIVER_TASK_USE_STD_THREAD)
+    std::this_thread::sleep_for(std::chrono::microseconds(sleepUs));
+#endif
+}
+
+/*!
+One iteration of predictive wake scheduling.
+
+Until the FramePredictor is locked, polls at the task interval and records when frames arrive.
+Once locked, sleeps until just before the next frame is expected, and then polls until the frame arrives or the deadline passes.
+*/
+void ReceiverTask::predictiveWakeLoop()
+{
+    if (!_framePredictor.isLocked()) {
+        // learning the frame period and phase
+        _pollTimeUs += _taskIntervalMicroseconds;
+        if (static_cast<int32_t>(timeUs() - _pollTimeUs) > 0) {
+            ++_overrunCount;
+            _wasDelayed = true;
+            _pollTimeUs = timeUs();
+        }
+        sleepUntil(_pollTimeUs);
+        RECEIVER_TRACE(TASK_WAKE, 1);
+        if (pollForFrame()) {
+            _framePredictor.onFrame(timeUs());
+        }
+        loop();
+        return;
+    }
+
+    sleepUntil(_framePredictor.getWakeTimeUs());
+    RECEIVER_TRACE(TASK_WAKE, 1);
+    const timeUs32_t deadlineUs = _framePredictor.getDeadlineUs();
+    while (!pollForFrame()) {
+        if (static_cast<int32_t>(timeUs() - deadlineUs) >= 0) {
+            // frame missed, if too many are missed the predictor unlocks and polling restarts
+            _framePredictor.onMiss();
+            _pollTimeUs = timeUs();
+#if defined(FRAMEWORK_USE_FREERTOS)
+            checkFailsafe(xTaskGetTickCount());
+#else
+            checkFailsafe(timeMs());
+#endif
+            return;
+        }
+        // poll in short steps, a receiver that signals from its ISR ends the wait as soon as the frame arrives
+#if defined(FRAMEWORK_USE_FREERTOS)
+        if (_receiver.WAIT_FOR_DATA_RECEIVED(1) > 0) {
+            break;
+        }
+#elif defined(RECEIVER_TASK_USE_STD_THREAD)
+        enum { POLL_INTERVAL_US = 50 };
+        std::this_thread::sleep_for(std::chrono::microseconds(POLL_INTERVAL_US));
+#endif
+    }
+    _framePredictor.onFrame(timeUs());
+    loop();
+}
+
+#if defined(RECEIVER_TASK_USE_STD_THREAD)
+ReceiverTask::~ReceiverTask()
+{
+    stop();
+}
+
+/*!
+Starts running the task on a thread.
+
+Returns false if the task is already running.
+*/
+bool ReceiverTask::start()
+{
+    if (_thread.joinable()) {
+        return false;
+    }
+    _stopRequested = false;
+    _thread = std::thread(&ReceiverTask::task, this);
+    return true;
+}
+
+/*!
+Requests the task to stop and waits for it to finish.
+
+In event driven mode, the task stops after its current wait, which is at most the cockpit timeout.
+*/
+void ReceiverTask::stop()
+{
+    _stopRequested = true;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+#endif // RECEIVER_TASK_USE_STD_THREAD
+
 /*!
 Wrapper function for ReceiverTask::Task with the correct signature to be used in xTaskCreate.
 */
-[[noreturn]] void ReceiverTask::Task(void* arg)
+#if defined(FRAMEWORK_USE_FREERTOS)
+[[noreturn]]
+#endif
+void ReceiverTask::Task(void* arg)
 {
     const TaskBase::parameters_t* parameters = static_cast<TaskBase::parameters_t*>(arg);
 
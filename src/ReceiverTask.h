@@ -1,26 +1,116 @@
 #pragma once
 
+#include "FramePredictor.h"
+#include "TaskSignal.h"
+
 #include <TaskBase.h> // NOLINT(clang-diagnostic-pragma-pack)
 
+#if defined(FRAMEWORK_USE_FREERTOS)
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+#include <esp_timer.h>
+#elif defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+#include <pico/time.h>
+#endif
+#endif
+
+#if !defined(FRAMEWORK_USE_FREERTOS) && (defined(FRAMEWORK_TEST) || defined(__linux__))
+#define RECEIVER_TASK_USE_STD_THREAD
+#include <atomic>
+#include <thread>
+#endif
+
 class CockpitBase;
 class ReceiverBase;
+class ReceiverFrameQueue;
 class ReceiverWatcher;
 
+/*!
+Task that reads the receiver and passes the controls to the cockpit.
+
+With FreeRTOS the task is started by createTask().
+
+In time based mode, if the task interval is not a whole number of RTOS ticks (for example 250us), then the task is woken by a periodic hardware timer
+(esp_timer on ESP32, a repeating alarm on RP2040), so the interval is microsecond accurate and does not drift.
+On other platforms, call setPeriodicTimerExternal() and call onPeriodicTimerFromISR() from a hardware timer ISR.
+Otherwise the interval is rounded to whole RTOS ticks.
+
+In predictive wake mode, set with setPredictiveWake(), the task polls at the task interval until it has learned the period and phase of the frames.
+It then sleeps until just before each frame is expected and waits for the frame, up to a deadline just after it is expected.
+This gives one wakeup per frame, with low latency, and lets tickless idle sleep between frames. After several missed frames the task reverts to polling and relearns.
+
+In decoupled mode, set with setFrameQueue(), the task does not call the cockpit. Instead it pushes each frame to the queue,
+and the cockpit's own task drains the queue, so a slow cockpit cannot stall the receiver task.
+On Linux and in native test builds there is no FreeRTOS scheduler, so call start() to run the task on a std::thread, and stop() to end it.
+*/
 class ReceiverTask : public TaskBase {
 public:
     ReceiverTask(uint32_t taskIntervalMicroseconds, ReceiverBase& receiver, CockpitBase& cockpit);
+#if defined(RECEIVER_TASK_USE_STD_THREAD)
+    ~ReceiverTask();
+#endif
+private:
+    // ReceiverTask is not copyable or moveable
+    ReceiverTask(const ReceiverTask&) = delete;
+    ReceiverTask& operator=(const ReceiverTask&) = delete;
+    ReceiverTask(ReceiverTask&&) = delete;
+    ReceiverTask& operator=(ReceiverTask&&) = delete;
 public:
     static ReceiverTask* createTask(task_info_t& taskInfo, ReceiverBase& receiver, CockpitBase& cockpit, uint8_t priority, uint32_t core, uint32_t taskIntervalMicroseconds);
     static ReceiverTask* createTask(ReceiverBase& receiver, CockpitBase& cockpit,uint8_t priority, uint32_t core, uint32_t taskIntervalMicroseconds);
     static ReceiverTask* createTask(task_info_t& taskInfo, ReceiverBase& receiver, CockpitBase& cockpit, uint8_t priority, uint32_t core);
     static ReceiverTask* createTask(ReceiverBase& receiver, CockpitBase& cockpit, uint8_t priority, uint32_t core);
 public:
+#if defined(FRAMEWORK_USE_FREERTOS)
     [[noreturn]] static void Task(void* arg);
+#else
+    static void Task(void* arg);
+#endif
     void loop();
+    uint32_t getOverrunCount() const { return _overrunCount; } //!< number of time based loops that started late, or were missed
+    void setPeriodicTimerExternal() { _periodicTimer = PERIODIC_TIMER_EXTERNAL; } //!< must be called before the task is started
+    void onPeriodicTimerFromISR() { _periodicSignal.SIGNAL_FROM_ISR(); }
+    void setPredictiveWake(bool predictiveWake) { _predictiveWake = predictiveWake; } //!< time based scheduling only, must be called before the task is started
+    const FramePredictor& getFramePredictor() const { return _framePredictor; }
+    void setFrameQueue(ReceiverFrameQueue* frameQueue) { _frameQueue = frameQueue; } //!< must be called before the task is started
+#if defined(RECEIVER_TASK_USE_STD_THREAD)
+    bool start();
+    void stop();
+    bool isRunning() const { return _thread.joinable(); }
+#endif
 private:
+#if defined(FRAMEWORK_USE_FREERTOS)
     [[noreturn]] void task();
+#else
+    void task();
+#endif
+    bool readAvailableData();
+    void checkFailsafe(uint32_t tickCount);
+    bool startPeriodicTimer();
+    void predictiveWakeLoop();
+    bool pollForFrame();
+    static void sleepUntil(timeUs32_t wakeTimeUs);
+    static void periodicTimerCallback(void* arg);
 private:
+    enum periodic_timer_e { PERIODIC_TIMER_NONE, PERIODIC_TIMER_INTERNAL, PERIODIC_TIMER_EXTERNAL };
     ReceiverBase& _receiver;
     CockpitBase& _cockpit;
     ReceiverWatcher* _receiverWatcher;
+    ReceiverFrameQueue* _frameQueue {nullptr};
+    uint32_t _overrunCount {};
+    periodic_timer_e _periodicTimer {PERIODIC_TIMER_NONE};
+    TaskSignal _periodicSignal {TaskSignal::NOTIFICATION_INDEX_PERIODIC}; //!< separate notification index, if available, so receiver data signals do not count as periods
+    bool _predictiveWake {false};
+    timeUs32_t _pollTimeUs {};
+    FramePredictor _framePredictor;
+#if defined(FRAMEWORK_USE_FREERTOS)
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+    esp_timer_handle_t _periodicTimerHandle {};
+#elif defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+    repeating_timer_t _repeatingTimer {};
+#endif
+#endif
+#if defined(RECEIVER_TASK_USE_STD_THREAD)
+    std::thread _thread;
+    std::atomic<bool> _stopRequested {false};
+#endif
 };
@@ -5,6 +5,7 @@
 #include <array>
 #include <cassert>
 #include <cstring>
+#include <new>
 
 #if defined(FRAMEWORK_USE_FREERTOS)
 
@@ -40,25 +41,59 @@ ReceiverTask* ReceiverTask::createTask(ReceiverBase& receiver, CockpitBase& cock
     return createTask(taskInfo, receiver, cockpit, priority, core, taskIntervalMicroseconds);
 }
 
+#if !defined(RECEIVER_TASK_MAX_COUNT)
+#define RECEIVER_TASK_MAX_COUNT 1
+#endif
+
+/*!
+Creates a task for the receiver. Each receiver needs its own task.
+
+Each task is statically allocated from a pool of RECEIVER_TASK_MAX_COUNT slots, each slot has its own task object, stack, and task buffer.
+Set RECEIVER_TASK_MAX_COUNT to the number of receivers that need their own task.
+
+Returns nullptr if all the slots have been used.
+*/
 ReceiverTask* ReceiverTask::createTask(task_info_t& taskInfo, ReceiverBase& receiver, CockpitBase& cockpit, uint8_t priority, uint32_t core, uint32_t taskIntervalMicroseconds)
 {
-    static ReceiverTask receiverTask(taskIntervalMicroseconds, receiver, cockpit);
+    static_assert(RECEIVER_TASK_MAX_COUNT >= 1 && RECEIVER_TASK_MAX_COUNT <= 10);
+    enum { MAX_COUNT = RECEIVER_TASK_MAX_COUNT };
+    static size_t taskCount = 0;
+    if (taskCount >= MAX_COUNT) {
+        // too many ReceiverTasks, increase RECEIVER_TASK_MAX_COUNT
+        return nullptr;
+    }
+    const size_t slot = taskCount;
+    ++taskCount;
 
-    // Note that task parameters must not be on the stack, since they are used when the task is started, which is after this function returns.
-    static TaskBase::parameters_t taskParameters { // NOLINT(misc-const-correctness) false positive
-        .task = &receiverTask,
+    // ReceiverTask has no default constructor, so reserve uninitialized storage and construct the task in place
+    struct receiver_task_storage_t {
+        alignas(ReceiverTask) std::array<uint8_t, sizeof(ReceiverTask)> data;
     };
+    static std::array<receiver_task_storage_t, MAX_COUNT> receiverTasks;
+    ReceiverTask* receiverTask = new (&receiverTasks[slot].data[0]) ReceiverTask(taskIntervalMicroseconds, receiver, cockpit);
+
+    // Note that task parameters must not be on the stack, since they are used when the task is started, which is after this function returns.
+    static std::array<TaskBase::parameters_t, MAX_COUNT> taskParameters; // NOLINT(misc-const-correctness) false positive
+    taskParameters[slot].task = receiverTask;
 #if !defined(RECEIVER_TASK_STACK_DEPTH_BYTES)
     enum { RECEIVER_TASK_STACK_DEPTH_BYTES = 4096 };
 #endif
 #if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32) || !defined(FRAMEWORK_USE_FREERTOS)
-    static std::array<uint8_t, RECEIVER_TASK_STACK_DEPTH_BYTES> stack;
+    static std::array<std::array<uint8_t, RECEIVER_TASK_STACK_DEPTH_BYTES>, MAX_COUNT> stacks;
 #else
-    static std::array<StackType_t, RECEIVER_TASK_STACK_DEPTH_BYTES / sizeof(StackType_t)> stack;
+    static std::array<std::array<StackType_t, RECEIVER_TASK_STACK_DEPTH_BYTES / sizeof(StackType_t)>, MAX_COUNT> stacks;
 #endif
+    auto& stack = stacks[slot];
+    // first task is "ReceiverTask", subsequent tasks are "ReceiverTask1", "ReceiverTask2" etc
+    static std::array<std::array<char, 16>, MAX_COUNT> names; // max length 16, including zero terminator
+    std::strcpy(&names[slot][0], "ReceiverTask");
+    if (slot > 0) {
+        names[slot][12] = static_cast<char>('0' + slot); // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+        names[slot][13] = 0; // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    }
     taskInfo = {
         .taskHandle = nullptr,
-        .name = "ReceiverTask", // max length 16, including zero terminator
+        .name = &names[slot][0],
         .stackDepthBytes = RECEIVER_TASK_STACK_DEPTH_BYTES,
         .stackBuffer = reinterpret_cast<uint8_t*>(&stack[0]), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
         .priority = priority,
@@ -69,13 +104,14 @@ ReceiverTask* ReceiverTask::createTask(task_info_t& taskInfo, ReceiverBase& rece
     assert(std::strlen(taskInfo.name) < configMAX_TASK_NAME_LEN);
     assert(taskInfo.priority < configMAX_PRIORITIES);
 
-    static StaticTask_t taskBuffer;
+    static std::array<StaticTask_t, MAX_COUNT> taskBuffers;
+    StaticTask_t& taskBuffer = taskBuffers[slot];
 #if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
     taskInfo.taskHandle = xTaskCreateStaticPinnedToCore(
         ReceiverTask::Task,
         taskInfo.name,
         taskInfo.stackDepthBytes / sizeof(StackType_t),
-        &taskParameters,
+        &taskParameters[slot],
         taskInfo.priority,
         &stack[0],
         &taskBuffer,
@@ -87,7 +123,7 @@ ReceiverTask* ReceiverTask::createTask(task_info_t& taskInfo, ReceiverBase& rece
         ReceiverTask::Task,
         taskInfo.name,
         taskInfo.stackDepthBytes / sizeof(StackType_t),
-        &taskParameters,
+        &taskParameters[slot],
         taskInfo.priority,
         &stack[0],
         &taskBuffer,
@@ -99,7 +135,7 @@ ReceiverTask* ReceiverTask::createTask(task_info_t& taskInfo, ReceiverBase& rece
         ReceiverTask::Task,
         taskInfo.name,
         taskInfo.stackDepthBytes / sizeof(StackType_t),
-        &taskParameters,
+        &taskParameters[slot],
         taskInfo.priority,
         &stack[0],
         &taskBuffer
@@ -111,5 +147,5 @@ ReceiverTask* ReceiverTask::createTask(task_info_t& taskInfo, ReceiverBase& rece
     (void)taskParameters;
 #endif // FRAMEWORK_USE_FREERTOS
 
-    return &receiverTask;
+    return receiverTask;
 }
@@ -1,3 +1,4 @@
+#include "ReceiverProbe.h"
 #include "ReceiverTelemetry.h"
 #include "ReceiverTelemetryData.h"
 
@@ -27,3 +28,51 @@ size_t packTelemetryData_Receiver(uint8_t* telemetryDataPtr, uint32_t id, uint32
 
     return td->len;
 };
+
+/*!
+Packs the receiver error statistics into a TD_RECEIVER_ERRORS packet. Returns the length of the packet.
+*/
+size_t packTelemetryData_ReceiverErrors(uint8_t* telemetryDataPtr, uint32_t id, uint32_t sequenceNumber, const ReceiverBase& receiver)
+{
+    TD_RECEIVER_ERRORS* td = reinterpret_cast<TD_RECEIVER_ERRORS*>(telemetryDataPtr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,hicpp-use-auto,modernize-use-auto)
+
+    td->id = id;
+    td->type = TD_RECEIVER_ERRORS::TYPE;
+    td->len = sizeof(TD_RECEIVER_ERRORS);
+    td->subType = TD_RECEIVER_ERRORS::SUB_TYPE;
+    td->sequenceNumber = static_cast<uint8_t>(sequenceNumber);
+
+    td->errorStatistics = receiver.getErrorStatistics();
+
+    return td->len;
+}
+
+#if defined(LIBRARY_RECEIVER_USE_PROBES)
+/*!
+Packs the receiver probe statistics into a TD_RECEIVER_PROBES packet. Returns the length of the packet.
+*/
+size_t packTelemetryData_ReceiverProbes(uint8_t* telemetryDataPtr, uint32_t id, uint32_t sequenceNumber)
+{
+    static_assert(static_cast<int>(TD_RECEIVER_PROBES::PROBE_COUNT) == static_cast<int>(ReceiverProbe::PROBE_COUNT));
+    TD_RECEIVER_PROBES* td = reinterpret_cast<TD_RECEIVER_PROBES*>(telemetryDataPtr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,hicpp-use-auto,modernize-use-auto)
+
+    td->id = id;
+    td->type = TD_RECEIVER_PROBES::TYPE;
+    td->len = sizeof(TD_RECEIVER_PROBES);
+    td->subType = TD_RECEIVER_PROBES::SUB_TYPE;
+    td->sequenceNumber = static_cast<uint8_t>(sequenceNumber);
+
+    for (size_t ii = 0; ii < TD_RECEIVER_PROBES::PROBE_COUNT; ++ii) {
+        const auto probeId = static_cast<ReceiverProbe::probe_id_e>(ii);
+        const ReceiverProbe::stats_t& stats = ReceiverProbe::getStats(probeId);
+        td->probes[ii] = {
+            .count = stats.count,
+            .minCycles = stats.count == 0 ? 0 : stats.minCycles,
+            .maxCycles = stats.maxCycles,
+            .meanCycles = ReceiverProbe::getMeanCycles(probeId)
+        };
+    }
+
+    return td->len;
+}
+#endif
@@ -6,3 +6,8 @@
 class ReceiverBase;
 
 size_t packTelemetryData_Receiver(uint8_t* telemetryDataPtr, uint32_t id, uint32_t sequenceNumber, const ReceiverBase& receiver); // NOLINT(readability-avoid-const-params-in-decls) false positive
+size_t packTelemetryData_ReceiverErrors(uint8_t* telemetryDataPtr, uint32_t id, uint32_t sequenceNumber, const ReceiverBase& receiver); // NOLINT(readability-avoid-const-params-in-decls) false positive
+
+#if defined(LIBRARY_RECEIVER_USE_PROBES)
+size_t packTelemetryData_ReceiverProbes(uint8_t* telemetryDataPtr, uint32_t id, uint32_t sequenceNumber);
+#endif
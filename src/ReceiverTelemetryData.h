@@ -28,4 +28,40 @@ struct TD_RECEIVER {
     };
     data_t data;
 };
+
+/*!
+Packet for the transmission of the receiver probe statistics, see ReceiverProbe.h.
+The probes are, in order: onDataReceivedFromISR, unpackPacket, update, and ReceiverTask::loop.
+*/
+struct TD_RECEIVER_PROBES {
+    enum { TYPE = 10, SUB_TYPE = 1 }; // same type as TD_RECEIVER, distinguished by subType
+    enum { PROBE_COUNT = 4 };
+    uint32_t id {0};
+    uint8_t type {TYPE};
+    uint8_t len {sizeof(TD_RECEIVER_PROBES)}; //!< length of whole packet, ie sizeof(TD_RECEIVER_PROBES)
+    uint8_t subType {SUB_TYPE};
+    uint8_t sequenceNumber {0};
+
+    struct probe_t {
+        uint32_t count;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint32_t meanCycles;
+    };
+    std::array<probe_t, PROBE_COUNT> probes;
+};
+
+/*!
+Packet for the transmission of the receiver error statistics, see ReceiverBase::error_statistics_t.
+*/
+struct TD_RECEIVER_ERRORS {
+    enum { TYPE = 10, SUB_TYPE = 2 }; // same type as TD_RECEIVER, distinguished by subType
+    uint32_t id {0};
+    uint8_t type {TYPE};
+    uint8_t len {sizeof(TD_RECEIVER_ERRORS)}; //!< length of whole packet, ie sizeof(TD_RECEIVER_ERRORS)
+    uint8_t subType {SUB_TYPE};
+    uint8_t sequenceNumber {0};
+
+    ReceiverBase::error_statistics_t errorStatistics;
+};
 #pragma pack(pop)
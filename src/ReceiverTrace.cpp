@@ -0,0 +1,69 @@
+#if defined(LIBRARY_RECEIVER_USE_TRACE)
+
+#include "ReceiverTrace.h"
+
+#include <TimeMicroseconds.h>
+
+
+std::array<ReceiverTrace::slot_t, ReceiverTrace::SIZE> ReceiverTrace::slots {};
+std::atomic<uint32_t> ReceiverTrace::writeIndex {0};
+
+/*!
+Records an event, may be called from an ISR.
+The slot's word1 is cleared while the slot is being written, so a concurrent dump() sees the slot as invalid.
+*/
+FAST_CODE void ReceiverTrace::record(event_type_e type, uint32_t arg)
+{
+    const uint32_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    slot_t& slot = slots[index & (SIZE - 1)];
+    slot.word1.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timeUs.store(timeUs(), std::memory_order_relaxed);
+    slot.word1.store(packWord1(type, index / SIZE, arg), std::memory_order_release);
+}
+
+/*!
+Copies up to maxCount of the most recent events into events, oldest first.
+Slots that are being written, or that were overwritten while being read, are skipped.
+
+Returns the number of events copied.
+*/
+size_t ReceiverTrace::dump(event_t* events, size_t maxCount)
+{
+    const uint32_t endIndex = writeIndex.load(std::memory_order_acquire);
+    const uint32_t count = endIndex < SIZE ? endIndex : static_cast<uint32_t>(SIZE);
+    uint32_t index = endIndex - (count < maxCount ? count : static_cast<uint32_t>(maxCount));
+
+    size_t eventCount = 0;
+    for (; index != endIndex; ++index) {
+        const slot_t& slot = slots[index & (SIZE - 1)];
+        const uint32_t word1 = slot.word1.load(std::memory_order_acquire);
+        const uint32_t time = slot.timeUs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (word1 == 0 || word1 != slot.word1.load(std::memory_order_relaxed) || ((word1 >> 16U) & 0xFFU) != ((index / SIZE) & 0xFFU)) {
+            continue;
+        }
+        events[eventCount] = { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            .timeUs = time,
+            .type = static_cast<uint8_t>(word1 >> 24U),
+            .reserved = 0,
+            .arg = static_cast<uint16_t>(word1 & 0xFFFFU)
+        };
+        ++eventCount;
+    }
+    return eventCount;
+}
+
+/*!
+Clears the trace, must not be called while events are being recorded.
+*/
+void ReceiverTrace::reset()
+{
+    for (slot_t& slot : slots) {
+        slot.word1.store(0, std::memory_order_relaxed);
+        slot.timeUs.store(0, std::memory_order_relaxed);
+    }
+    writeIndex.store(0, std::memory_order_release);
+}
+
+#endif // LIBRARY_RECEIVER_USE_TRACE
@@ -0,0 +1,82 @@
+#pragma once
+
+/*!
+Trace of receive path events, for seeing the ordering and timing of ISR byte bursts, completed frames, CRC failures,
+task wakeups, cockpit updates and failsafe checks on a single timeline.
+
+Enabled by defining LIBRARY_RECEIVER_USE_TRACE, otherwise RECEIVER_TRACE() expands to nothing and there is no trace code or storage.
+
+Events are recorded into a fixed size ring of RECEIVER_TRACE_SIZE events, the oldest events are overwritten.
+Recording is lock-free and may be done from ISRs and from tasks on either core: each event claims its slot with an atomic increment.
+A slot is cleared while it is being written, and its type and arg word is tagged with the low 8 bits of the lap of the ring,
+so dump() skips any slot that is being written, or that has been overwritten by a later lap, while it is read.
+Since the slot is claimed before the time is read, an event may have a slightly earlier time than the event recorded before it.
+(On Cortex-M0+, which has no atomic read-modify-write instructions, the increment is done by the compiler runtime with interrupts disabled.)
+
+Use dump() to copy the events, oldest first, into an array of event_t, which can be sent to a host as binary.
+On the host ReceiverTraceDecoder converts the events into Chrome trace event JSON, which can be loaded into Perfetto or chrome://tracing.
+*/
+#if defined(LIBRARY_RECEIVER_USE_TRACE)
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(FAST_CODE)
+#if defined(FRAMEWORK_ESPIDF)
+#define FAST_CODE IRAM_ATTR
+#else
+#define FAST_CODE
+#endif
+#endif
+
+#if !defined(RECEIVER_TRACE_SIZE)
+#define RECEIVER_TRACE_SIZE 256
+#endif
+
+
+class ReceiverTrace {
+public:
+    enum event_type_e : uint8_t {
+        NONE,
+        ISR_BYTE_BURST, //!< arg is the number of bytes read in the ISR, 0 if not known
+        FRAME_COMPLETE, //!< a protocol parser has completed a frame
+        CRC_FAILURE, //!< a frame was rejected because its CRC or checksum was incorrect
+        TASK_WAKE, //!< arg is the value returned by the wait, 0 means timeout
+        COCKPIT_UPDATE, //!< controls given to the cockpit, or pushed to the frame queue
+        FAILSAFE_CHECK,
+        EVENT_TYPE_COUNT
+    };
+    enum { SIZE = RECEIVER_TRACE_SIZE };
+    static_assert((SIZE & (SIZE - 1)) == 0, "RECEIVER_TRACE_SIZE must be a power of 2");
+    //! compact binary form of an event, as returned by dump()
+    struct event_t {
+        uint32_t timeUs;
+        uint8_t type;
+        uint8_t reserved;
+        uint16_t arg;
+    };
+public:
+    static void record(event_type_e type, uint32_t arg);
+    static size_t dump(event_t* events, size_t maxCount);
+    static void reset();
+    static uint32_t getRecordCount() { return writeIndex.load(std::memory_order_relaxed); }
+private:
+    // an event is packed into two words, word1 holds type, lap and arg, so the lap can be used to check the slot has not been overwritten
+    static uint32_t packWord1(event_type_e type, uint32_t lap, uint32_t arg) { return (static_cast<uint32_t>(type) << 24U) | ((lap & 0xFFU) << 16U) | (arg & 0xFFFFU); }
+    struct slot_t {
+        std::atomic<uint32_t> timeUs;
+        std::atomic<uint32_t> word1;
+    };
+    static std::array<slot_t, SIZE> slots;
+    static std::atomic<uint32_t> writeIndex;
+};
+
+#define RECEIVER_TRACE(type, arg) ReceiverTrace::record(ReceiverTrace::type, arg) // NOLINT(cppcoreguidelines-macro-usage)
+
+#else
+
+#define RECEIVER_TRACE(type, arg) // NOLINT(cppcoreguidelines-macro-usage)
+
+#endif // LIBRARY_RECEIVER_USE_TRACE
@@ -0,0 +1,116 @@
+#if defined(LIBRARY_RECEIVER_USE_TRACE)
+
+#include "ReceiverTraceDecoder.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+
+const char* ReceiverTraceDecoder::eventName(uint8_t type)
+{
+    switch (type) {
+    case ReceiverTrace::ISR_BYTE_BURST:
+        return "ISR byte burst";
+    case ReceiverTrace::FRAME_COMPLETE:
+        return "frame complete";
+    case ReceiverTrace::CRC_FAILURE:
+        return "CRC failure";
+    case ReceiverTrace::TASK_WAKE:
+        return "task wake";
+    case ReceiverTrace::COCKPIT_UPDATE:
+        return "cockpit update";
+    case ReceiverTrace::FAILSAFE_CHECK:
+        return "failsafe check";
+    default:
+        return "unknown";
+    }
+}
+
+ReceiverTraceDecoder::track_e ReceiverTraceDecoder::eventTrack(uint8_t type)
+{
+    switch (type) {
+    case ReceiverTrace::ISR_BYTE_BURST:
+        return TRACK_ISR;
+    case ReceiverTrace::FRAME_COMPLETE:
+    case ReceiverTrace::CRC_FAILURE:
+        return TRACK_PARSER;
+    default:
+        return TRACK_TASK;
+    }
+}
+
+/*!
+Returns the interval between two events, allowing for the 32-bit time wrapping.
+The interval is signed, since to is not always later than from, so intervals must be less than 2^31 microseconds (about 35 minutes).
+*/
+int32_t ReceiverTraceDecoder::intervalUs(const ReceiverTrace::event_t& from, const ReceiverTrace::event_t& to)
+{
+    return static_cast<int32_t>(to.timeUs - from.timeUs);
+}
+
+namespace {
+/*!
+Appends to a JSON buffer, like snprintf the length is tracked even when the buffer is full, so the required size can be found.
+*/
+struct json_writer_t {
+    char* buf;
+    size_t size;
+    size_t length;
+    void append(const char* format, ...) __attribute__((format(printf, 2, 3))) { // NOLINT(cert-dcl50-cpp)
+        va_list args; // NOLINT(cppcoreguidelines-init-variables)
+        va_start(args, format);
+        const size_t remaining = length < size ? size - length : 0;
+        const int written = vsnprintf(remaining > 0 ? buf + length : nullptr, remaining, format, args); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        va_end(args);
+        if (written > 0) {
+            length += static_cast<size_t>(written);
+        }
+    }
+};
+} // end namespace
+
+/*!
+Writes the events as Chrome trace event JSON into json, which is zero terminated if size is non-zero.
+
+Returns the length of the JSON, excluding the terminator. If this is not less than size, the JSON was truncated.
+*/
+size_t ReceiverTraceDecoder::toChromeTraceJSON(char* json, size_t size, const ReceiverTrace::event_t* events, size_t count)
+{
+    json_writer_t writer { .buf = json, .size = size, .length = 0 };
+    if (size > 0) {
+        json[0] = 0;
+    }
+
+    writer.append("{\"traceEvents\":[\n");
+    // name the tracks
+    writer.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"UART ISR\"}},\n", TRACK_ISR);
+    writer.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"parser\"}},\n", TRACK_PARSER);
+    writer.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"ReceiverTask\"}}", TRACK_TASK);
+
+    // Events are in the order their slots were claimed, but an ISR or the other core may claim a slot and read the time
+    // between another event claiming its slot and reading the time, so an event may have a slightly earlier time than the event before it.
+    // So the interval between events is signed, and the earliest event is found so that all the timestamps are non-negative.
+    int64_t traceTimeUs = 0;
+    int64_t earliestTimeUs = 0;
+    for (size_t ii = 1; ii < count; ++ii) {
+        traceTimeUs += intervalUs(events[ii - 1], events[ii]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (traceTimeUs < earliestTimeUs) {
+            earliestTimeUs = traceTimeUs;
+        }
+    }
+
+    traceTimeUs = 0;
+    for (size_t ii = 0; ii < count; ++ii) {
+        const ReceiverTrace::event_t& event = events[ii]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (ii > 0) {
+            traceTimeUs += intervalUs(events[ii - 1], event); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        writer.append(",\n{\"name\":\"%s\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":1,\"tid\":%d,\"args\":{\"arg\":%u}}",
+            eventName(event.type), static_cast<long long>(traceTimeUs - earliestTimeUs), eventTrack(event.type), static_cast<unsigned>(event.arg)); // NOLINT(google-runtime-int)
+    }
+    writer.append("\n]}\n");
+
+    return writer.length;
+}
+
+#endif // LIBRARY_RECEIVER_USE_TRACE
@@ -0,0 +1,27 @@
+#pragma once
+
+#if defined(LIBRARY_RECEIVER_USE_TRACE)
+
+#include "ReceiverTrace.h"
+
+
+/*!
+Host side decoder for a ReceiverTrace dump.
+
+Converts the events to Chrome trace event JSON, as used by Perfetto and chrome://tracing.
+Each event is an instant event, on one of three tracks: the UART ISR, the protocol parser and the ReceiverTask.
+Timestamps are microseconds from the earliest event, allowing for the 32-bit microsecond time wrapping.
+
+The dump is an array of ReceiverTrace::event_t, which is little endian, as are all the targets.
+*/
+class ReceiverTraceDecoder {
+public:
+    enum track_e { TRACK_ISR = 1, TRACK_PARSER = 2, TRACK_TASK = 3 };
+public:
+    static const char* eventName(uint8_t type);
+    static track_e eventTrack(uint8_t type);
+    static int32_t intervalUs(const ReceiverTrace::event_t& from, const ReceiverTrace::event_t& to);
+    static size_t toChromeTraceJSON(char* json, size_t size, const ReceiverTrace::event_t* events, size_t count);
+};
+
+#endif // LIBRARY_RECEIVER_USE_TRACE
@@ -0,0 +1,219 @@
+#if defined(__linux__)
+
+#include "ReceiverUDP.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+ReceiverUDP::ReceiverUDP(uint16_t port, uint32_t bindAddress) :
+    _port(port),
+    _bindAddress(bindAddress)
+{
+}
+
+ReceiverUDP::~ReceiverUDP()
+{
+    if (_socket >= 0) {
+        close(_socket);
+    }
+}
+
+/*!
+Opens and binds the socket.
+
+Returns false on failure.
+*/
+bool ReceiverUDP::init()
+{
+    _socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (_socket < 0) {
+        return false;
+    }
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(_port);
+    address.sin_addr.s_addr = htonl(_bindAddress);
+    if (bind(_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        close(_socket);
+        _socket = -1;
+        return false;
+    }
+    // the message headers are set up once, recvmmsg() only updates the lengths and flags
+    for (size_t ii = 0; ii < BATCH_SIZE; ++ii) {
+        _iovecs[ii].iov_base = &_buffers[ii][0];
+        _iovecs[ii].iov_len = MAX_FRAME_SIZE;
+        _messages[ii].msg_hdr.msg_iov = &_iovecs[ii];
+        _messages[ii].msg_hdr.msg_iovlen = 1;
+    }
+    socklen_t addressLength = sizeof(address);
+    if (getsockname(_socket, reinterpret_cast<sockaddr*>(&address), &addressLength) == 0) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        _port = ntohs(address.sin_port);
+    }
+    _packetCount = 0;
+    return true;
+}
+
+/*!
+Waits for a datagram to arrive. Ticks are milliseconds.
+
+Returns 1 if there is data to read, 0 on timeout.
+*/
+int32_t ReceiverUDP::WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait)
+{
+    pollfd pfd { .fd = _socket, .events = POLLIN, .revents = 0 };
+    return poll(&pfd, 1, static_cast<int>(ticksToWait)) > 0 ? 1 : 0;
+}
+
+size_t ReceiverUDP::packFrame(uint8_t* buf, uint32_t sequence, const uint16_t* channels, size_t channelCount)
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    size_t pos = 0;
+    for (size_t ii = 0; ii < 4; ++ii) {
+        buf[pos++] = static_cast<uint8_t>(MAGIC >> (8*ii));
+    }
+    for (size_t ii = 0; ii < 4; ++ii) {
+        buf[pos++] = static_cast<uint8_t>(sequence >> (8*ii));
+    }
+    buf[pos++] = static_cast<uint8_t>(channelCount);
+    buf[pos++] = static_cast<uint8_t>(channelCount >> 8U);
+    for (size_t ii = 0; ii < channelCount; ++ii) {
+        buf[pos++] = static_cast<uint8_t>(channels[ii]);
+        buf[pos++] = static_cast<uint8_t>(channels[ii] >> 8U);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return pos;
+}
+
+bool ReceiverUDP::isValidFrame(const uint8_t* frame, size_t length) const
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (length < HEADER_SIZE) {
+        return false;
+    }
+    const uint32_t magic = frame[0] | (frame[1] << 8U) | (frame[2] << 16U) | (static_cast<uint32_t>(frame[3]) << 24U);
+    const size_t channelCount = frame[8] | (frame[9] << 8U);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return magic == MAGIC && channelCount >= STICK_COUNT && channelCount <= CHANNEL_COUNT && length == HEADER_SIZE + 2*channelCount;
+}
+
+/*!
+Reads all queued datagrams, in batches, and unpacks the newest valid frame.
+
+Returns true if a new valid frame was received, false otherwise.
+*/
+bool ReceiverUDP::unpackPacket()
+{
+    if (_socket < 0) {
+        return false;
+    }
+
+    bool newFrame = false;
+    uint32_t supersededFrameCount = 0;
+    uint32_t newestSequence = 0;
+    int count = BATCH_SIZE;
+    while (count == BATCH_SIZE) {
+        count = recvmmsg(_socket, &_messages[0], BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (count <= 0) {
+            break;
+        }
+        const uint8_t* newest = nullptr;
+        for (size_t ii = 0; ii < static_cast<size_t>(count); ++ii) {
+            const uint8_t* frame = &_buffers[ii][0];
+            if ((_messages[ii].msg_hdr.msg_flags & MSG_TRUNC) || !isValidFrame(frame, _messages[ii].msg_len)) {
+                ++_invalidFrameCount;
+                continue;
+            }
+            const uint32_t sequence = frame[4] | (frame[5] << 8U) | (frame[6] << 16U) | (static_cast<uint32_t>(frame[7]) << 24U); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (newFrame && static_cast<int32_t>(sequence - newestSequence) <= 0) {
+                ++_staleFrameCount;
+                continue;
+            }
+            if (!newFrame && !isNewer(sequence)) {
+                ++_staleFrameCount;
+                ++_consecutiveStaleFrameCount;
+                if (_consecutiveStaleFrameCount < RESYNC_STALE_FRAME_COUNT) {
+                    continue;
+                }
+                // the sender has restarted its sequence, so resynchronize on this frame
+                _sequenceValid = false;
+            }
+            if (newFrame) {
+                ++supersededFrameCount;
+            }
+            newest = frame;
+            newestSequence = sequence;
+            newFrame = true;
+        }
+        if (newest != nullptr) {
+            // copy the newest frame, since the next batch overwrites the buffers
+            std::copy(newest, newest + MAX_FRAME_SIZE, &_newestFrame[0]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    if (!newFrame) {
+        return false;
+    }
+
+    // frames missing from the sequence, other than those superseded by a newer frame, have been dropped
+    _supersededFrameCount += supersededFrameCount;
+    if (_sequenceValid) {
+        const auto missing = static_cast<int32_t>(newestSequence - _sequence - 1) - static_cast<int32_t>(supersededFrameCount);
+        if (missing > 0 && missing < MAX_COUNTED_SEQUENCE_GAP) {
+            _droppedPacketCount += missing;
+        }
+    }
+    _consecutiveStaleFrameCount = 0;
+    _sequence = newestSequence;
+    _sequenceValid = true;
+    _channelCount = _newestFrame[8] | (_newestFrame[9] << 8U);
+    _auxiliaryChannelCount = _channelCount - STICK_COUNT;
+    for (size_t ii = 0; ii < _channelCount; ++ii) {
+        _channels[ii] = static_cast<uint16_t>(_newestFrame[HEADER_SIZE + 2*ii] | (_newestFrame[HEADER_SIZE + 2*ii + 1] << 8U));
+    }
+    return true;
+}
+
+bool ReceiverUDP::update(uint32_t tickCountDelta)
+{
+    if (!unpackPacket()) {
+        return false;
+    }
+
+    _packetReceived = true;
+    ++_packetCount;
+    _tickCountDelta = tickCountDelta;
+
+    // track dropped packets
+    _droppedPacketCountDelta = _droppedPacketCount - _droppedPacketCountPrevious;
+    _droppedPacketCountPrevious = _droppedPacketCount;
+
+    // NOTE: there is no mutex around this flag
+    _newPacketAvailable = true;
+    return true;
+}
+
+/*!
+Maps channels in range [1000,2000] to floats in range [0,1] for throttle, [-1,1] for roll, pitch yaw
+*/
+void ReceiverUDP::getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const
+{
+    throttleStick = (static_cast<float>(_channels[THROTTLE]) - CHANNEL_RANGE_F) / CHANNEL_RANGE_F;
+    rollStick = (static_cast<float>(_channels[ROLL]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    pitchStick = (static_cast<float>(_channels[PITCH]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+    yawStick = (static_cast<float>(_channels[YAW]) - CHANNEL_MIDDLE_F) / CHANNEL_RANGE_F;
+}
+
+uint16_t ReceiverUDP::getChannelPWM(size_t index) const
+{
+    if (index >= _channelCount) {
+        return CHANNEL_LOW;
+    }
+    return _channels[index];
+}
+
+#endif // __linux__
@@ -0,0 +1,77 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include "ReceiverBase.h"
+
+#include <array>
+#include <sys/socket.h>
+
+
+/*!
+UDP network receiver, for Software In The Loop (SITL) simulation on Linux.
+
+Each datagram is one frame, all values little-endian
+    4 byte magic number ("RCUD")
+    4 byte sequence number, incremented for each frame sent
+    2 byte channel count
+    2 bytes per channel, in microseconds
+
+All queued datagrams are read with a single recvmmsg() call per batch, and only the newest valid frame is used.
+Frames with a sequence number that is not newer than the last frame used are discarded, sequence numbers may wrap around.
+If many consecutive frames are discarded like this, then the sender is assumed to have restarted and the receiver resynchronizes.
+*/
+class ReceiverUDP : public ReceiverBase {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 18;
+    static constexpr uint32_t MAGIC = 0x44554352; // "RCUD" little-endian
+    enum { HEADER_SIZE = 10, MAX_FRAME_SIZE = HEADER_SIZE + 2*CHANNEL_COUNT };
+    enum { BATCH_SIZE = 32 }; // maximum number of datagrams read by one recvmmsg() call
+    enum { RESYNC_STALE_FRAME_COUNT = 8 }; // resynchronize after this many consecutive stale frames, since the sender has probably restarted
+    enum { MAX_COUNTED_SEQUENCE_GAP = 1000 }; // larger gaps in the sequence are not counted as dropped frames
+    static constexpr uint32_t ANY_ADDRESS = 0;
+public:
+    explicit ReceiverUDP(uint16_t port, uint32_t bindAddress = ANY_ADDRESS);
+    virtual ~ReceiverUDP() override;
+    bool init();
+private:
+    // ReceiverUDP is not copyable or moveable
+    ReceiverUDP(const ReceiverUDP&) = delete;
+    ReceiverUDP& operator=(const ReceiverUDP&) = delete;
+    ReceiverUDP(ReceiverUDP&&) = delete;
+    ReceiverUDP& operator=(ReceiverUDP&&) = delete;
+public:
+    virtual int32_t WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) override;
+    virtual bool update(uint32_t tickCountDelta) override;
+    virtual bool unpackPacket() override;
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override;
+    virtual uint16_t getChannelPWM(size_t index) const override;
+    uint16_t getPort() const { return _port; } //!< the port bound to, which is assigned by the system if port 0 was requested
+    uint32_t getSequence() const { return _sequence; }
+    uint32_t getChannelCount() const { return _channelCount; }
+    uint32_t getInvalidFrameCount() const { return _invalidFrameCount; }
+    uint32_t getStaleFrameCount() const { return _staleFrameCount; }
+    uint32_t getSupersededFrameCount() const { return _supersededFrameCount; }
+    static size_t packFrame(uint8_t* buf, uint32_t sequence, const uint16_t* channels, size_t channelCount);
+private:
+    bool isNewer(uint32_t sequence) const { return !_sequenceValid || static_cast<int32_t>(sequence - _sequence) > 0; }
+    bool isValidFrame(const uint8_t* frame, size_t length) const;
+private:
+    int _socket {-1};
+    uint16_t _port;
+    uint32_t _bindAddress;
+    std::array<std::array<uint8_t, MAX_FRAME_SIZE>, BATCH_SIZE> _buffers {};
+    std::array<uint8_t, MAX_FRAME_SIZE> _newestFrame {};
+    std::array<iovec, BATCH_SIZE> _iovecs {};
+    std::array<mmsghdr, BATCH_SIZE> _messages {};
+    std::array<uint16_t, CHANNEL_COUNT> _channels {};
+    uint32_t _channelCount {};
+    uint32_t _sequence {};
+    uint8_t _sequenceValid {false};
+    uint32_t _invalidFrameCount {};
+    uint32_t _staleFrameCount {};
+    uint32_t _consecutiveStaleFrameCount {};
+    uint32_t _supersededFrameCount {};
+};
+
+#endif // __linux__
@@ -1,6 +1,7 @@
 #include "SerialPort.h"
 
 #include "ReceiverBase.h"
+#include "ReceiverTrace.h"
 
 #if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
 #include <hardware/gpio.h>
@@ -15,51 +16,172 @@ static inline uint16_t gpioPin(uint8_t pin) { return static_cast<uint16_t>(1U <<
 
 
 /*!
-Pointer to the receiver used by the ISR.
+SerialPort instances, indexed by UART index, used by the ISRs.
 */
-SerialPort* SerialPort::self;
+std::array<SerialPort*, SerialPort::UART_COUNT> SerialPort::instances {};
 
 
 #if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
-void __not_in_flash_func(SerialPort::dataReadyISR)() // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+void __not_in_flash_func(SerialPort::dataReadyInstanceISR)() // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
 {
-    //gpio_put(PICO_DEFAULT_LED_PIN, 1);
-    while (uart_is_readable(self->_uart)) {
-        // Read 1 byte from UART buffer and give it to the RX protocol parser
-        const uint8_t data = uart_getc(self->_uart);
-        if (self->onDataReceivedFromISR(data)) {
-            // onDataReceived returns true once packet is complete
-            self->SIGNAL_DATA_READY_FROM_ISR();
+    bool signal = false;
+    [[maybe_unused]] uint32_t byteCount = 0;
+    while (uart_is_readable(_uart)) {
+        // Read 1 byte from UART buffer and give it to the RX protocol parser, or the deferred ring
+        // the data register is read directly, rather than using uart_getc(), since it also holds the error flags for the byte
+        const uint32_t dr = uart_get_hw(_uart)->dr;
+        if (dr & (UART_UARTDR_OE_BITS | UART_UARTDR_FE_BITS | UART_UARTDR_PE_BITS)) {
+            onErrorFromISR(((dr & UART_UARTDR_OE_BITS) ? UART_ERROR_OVERRUN : 0U)
+                | ((dr & UART_UARTDR_FE_BITS) ? UART_ERROR_FRAMING : 0U)
+                | ((dr & UART_UARTDR_PE_BITS) ? UART_ERROR_PARITY : 0U));
         }
+        const auto data = static_cast<uint8_t>(dr & UART_UARTDR_DATA_BITS);
+        ++byteCount;
+        if (receiveByteFromISR(data)) {
+            signal = true;
+        }
+    }
+    RECEIVER_TRACE(ISR_BYTE_BURST, byteCount);
+    if (signal) {
+        // signal once per interrupt, in deferred mode this means once per FIFO burst rather than once per byte
+        SIGNAL_DATA_READY_FROM_ISR();
     }
 }
-#elif defined(FRAMEWORK_STM32_CUBE)
+
+void __not_in_flash_func(SerialPort::dataReadyISR_UART0)() // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+{
+    SerialPort* serialPort = instances[UART_INDEX_0];
+    if (serialPort != nullptr) {
+        serialPort->dataReadyInstanceISR();
+    }
+}
+
+void __not_in_flash_func(SerialPort::dataReadyISR_UART1)() // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+{
+    SerialPort* serialPort = instances[UART_INDEX_1];
+    if (serialPort != nullptr) {
+        serialPort->dataReadyInstanceISR();
+    }
+}
+#elif defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
+#if defined(LIBRARY_RECEIVER_DEFINE_UART_CALLBACKS)
 // ISR called back when byte received on uart
-#if false
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) // cppcheck-suppress constParameterPointer
+// The STM32duino core, and many STM32Cube applications, define these callbacks, so they are only defined here if asked for.
+// Otherwise the application's callbacks must call SerialPort::dataReadyISR() and SerialPort::errorISR().
+extern "C" void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) // cppcheck-suppress constParameterPointer
 {
     SerialPort::dataReadyISR(huart);
 }
+
+// ISR called back when there is a receive error on uart
+extern "C" void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) // cppcheck-suppress constParameterPointer
+{
+    SerialPort::errorISR(huart);
+}
 #endif
 
-FAST_CODE void SerialPort::dataReadyISR(const UART_HandleTypeDef *huart) // NOLINT(readability-convert-member-functions-to-static)
+FAST_CODE void SerialPort::dataReadyInstanceISR()
 {
-    if (huart->Instance == self->_uart.Instance) {
-        if (self->onDataReceivedFromISR(self->_rxByte)) {
-            // onDataReceived returns true once packet is complete
-            self->SIGNAL_DATA_READY_FROM_ISR();
-        }
-        // Re-enable the interrupt for the next byte
-        HAL_UART_Receive_IT(&self->_uart, &self->_rxByte, 1);
+    RECEIVER_TRACE(ISR_BYTE_BURST, 1);
+    if (receiveByteFromISR(_rxByte)) {
+        SIGNAL_DATA_READY_FROM_ISR();
+    }
+    // Re-enable the interrupt for the next byte
+    HAL_UART_Receive_IT(&_uart, &_rxByte, 1);
+}
+
+/*!
+Returns the UART index of the UART with the given registers, using the same mapping as init(), or UART_COUNT if there is no such UART.
+STM32 indices are 1-based.
+
+This is a single chain of comparisons, in UART index order, so the cost is fixed for each UART.
+*/
+static inline uint8_t uartIndex(const USART_TypeDef* registers)
+{
+    return
+        (registers == USART1) ? SerialPort::UART_INDEX_0 :
+#if defined(USART2)
+        (registers == USART2) ? SerialPort::UART_INDEX_1 :
+#endif
+#if defined(USART3)
+        (registers == USART3) ? SerialPort::UART_INDEX_2 :
+#endif
+#if defined(UART4)
+        (registers == UART4) ? SerialPort::UART_INDEX_3 :
+#endif
+#if defined(UART5)
+        (registers == UART5) ? SerialPort::UART_INDEX_4 :
+#endif
+#if defined(USART6)
+        (registers == USART6) ? SerialPort::UART_INDEX_5 :
+#endif
+        SerialPort::UART_COUNT;
+}
+
+/*!
+Returns the SerialPort that owns huart, or nullptr if huart is the handle of a UART used by other code.
+
+The UART index is found from the handle's Instance, and then the SerialPort from the instances table.
+*/
+FAST_CODE SerialPort* SerialPort::getInstance(const UART_HandleTypeDef *huart)
+{
+    SerialPort* serialPort = getInstance(uartIndex(huart->Instance));
+    // check the handle is the SerialPort's own handle, and not another handle for the same UART
+    return (serialPort != nullptr && &serialPort->_uart == huart) ? serialPort : nullptr;
+}
+
+/*!
+Called from HAL_UART_RxCpltCallback, ignores handles that are not owned by a SerialPort.
+*/
+FAST_CODE void SerialPort::dataReadyISR(const UART_HandleTypeDef *huart)
+{
+    SerialPort* serialPort = getInstance(huart);
+    if (serialPort != nullptr) {
+        serialPort->dataReadyInstanceISR();
+    }
+}
+
+/*!
+Records the receive errors reported by the HAL. The HAL stops interrupt driven reception on an error, so it is restarted.
+*/
+FAST_CODE void SerialPort::errorInstanceISR()
+{
+    const uint32_t errorCode = HAL_UART_GetError(&_uart);
+    onErrorFromISR(((errorCode & HAL_UART_ERROR_ORE) ? UART_ERROR_OVERRUN : 0U)
+        | ((errorCode & HAL_UART_ERROR_FE) ? UART_ERROR_FRAMING : 0U)
+        | ((errorCode & HAL_UART_ERROR_PE) ? UART_ERROR_PARITY : 0U));
+    HAL_UART_Receive_IT(&_uart, &_rxByte, 1);
+}
+
+/*!
+Called from HAL_UART_ErrorCallback, ignores handles that are not owned by a SerialPort.
+*/
+FAST_CODE void SerialPort::errorISR(const UART_HandleTypeDef *huart)
+{
+    SerialPort* serialPort = getInstance(huart);
+    if (serialPort != nullptr) {
+        serialPort->errorInstanceISR();
     }
 }
 #else
-FAST_CODE void SerialPort::dataReadyISR()
+FAST_CODE void SerialPort::dataReadyInstanceISR()
 {
-    self->SIGNAL_DATA_READY_FROM_ISR();
+    RECEIVER_TRACE(ISR_BYTE_BURST, 0);
+    SIGNAL_DATA_READY_FROM_ISR();
 }
 #endif
 
+/*!
+ISR for the given UART index, does nothing if there is no SerialPort for that UART.
+*/
+FAST_CODE void SerialPort::dataReadyISR(uint8_t uartIndex)
+{
+    SerialPort* serialPort = getInstance(uartIndex);
+    if (serialPort != nullptr) {
+        serialPort->dataReadyInstanceISR();
+    }
+}
+
 /*!
 Negative pin means it is inverted.
 */
@@ -80,6 +202,13 @@ SerialPort::SerialPort(SerialPortWatcherBase* watcher, const serial_pins_t& pins
 {
 }
 
+SerialPort::~SerialPort()
+{
+    if (getInstance(_uartIndex) == this) {
+        instances[_uartIndex] = nullptr;
+    }
+}
+
 SerialPort::SerialPort(const stm32_uart_pins_t& pins, uint8_t uartIndex, uint32_t baudrate, uint8_t dataBits, uint8_t stopBits, uint8_t parity) :
     SerialPort(nullptr, serial_pins_t{{pins.tx.port,pins.tx.pin,false},{pins.rx.port,pins.rx.pin,false}}, uartIndex, baudrate, dataBits, stopBits, parity)
 {
@@ -90,8 +219,14 @@ SerialPort::SerialPort(const uart_pins_t& pins, uint8_t uartIndex, uint32_t baud
 {
 }
 
+/*!
+Initializes the UART and registers this instance so the ISR for its UART dispatches to it.
+*/
 void SerialPort::init() // NOLINT(readability-make-member-function-const)
 {
+    if (_uartIndex < UART_COUNT) {
+        instances[_uartIndex] = this;
+    }
 #if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
     // see https://github.com/victorhook/asac-fc/blob/main/src/receiver.c
     _uart = uart_get_instance(_uartIndex);
@@ -112,7 +247,7 @@ void SerialPort::init() // NOLINT(readability-make-member-function-const)
 
     // Enable UART interrupt
     const irq_num_t irqNum = _uartIndex == 0 ? UART0_IRQ : UART1_IRQ;
-    irq_set_exclusive_handler(irqNum, dataReadyISR);
+    irq_set_exclusive_handler(irqNum, _uartIndex == 0 ? dataReadyISR_UART0 : dataReadyISR_UART1);
     irq_set_enabled(irqNum, true);
     enum { RX_NEEDS_DATA = true, RX_DOES_NOT_NEED_DATA = false };
     enum { TX_NEEDS_DATA = true, TX_DOES_NOT_NEED_DATA = false };
@@ -235,10 +370,6 @@ void SerialPort::init() // NOLINT(readability-make-member-function-const)
 
     uartInit();
 
-    // Enable UART interrupt, calls back HAL_UART_RxCpltCallback when data received
-    HAL_UART_Receive_IT(&_uart, &_rxByte, 1);
-
-
 #elif defined(FRAMEWORK_TEST)
 
 #else // defaults to FRAMEWORK_ARDUINO
@@ -247,6 +378,19 @@ void SerialPort::init() // NOLINT(readability-make-member-function-const)
     _uart.begin(_baudrate, config, _pins.rx.pin, _pins.tx.pin);
 #endif
 #endif
+    startReceive();
+}
+
+/*!
+Starts reception. On STM32 interrupt driven reception is one byte at a time, so it must be restarted whenever the UART is reinitialized.
+*/
+void SerialPort::startReceive()
+{
+#if defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
+    // Enable UART interrupt, calls back HAL_UART_RxCpltCallback when data received
+    HAL_UART_Receive_IT(&_uart, &_rxByte, 1);
+#endif
+    _receiving = true;
 }
 
 void SerialPort::uartInit() // NOLINT(readability-make-member-function-const)
@@ -284,6 +428,9 @@ int32_t SerialPort::WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) // NOLINT(reada
 
 bool SerialPort::isDataAvailable() const
 {
+    if (_deferredRing) {
+        return !_deferredRing->empty();
+    }
 #if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
     return uart_is_readable(_uart);
 #elif defined(FRAMEWORK_ESPIDF)
@@ -302,10 +449,15 @@ bool SerialPort::isDataAvailable() const
 }
 
 /*!
-Used to get received byte when using time-based scheduling.
+Used to get received byte when using time-based scheduling, or in deferred mode.
 */
 uint8_t SerialPort::readByte()
 {
+    if (_deferredRing) {
+        uint8_t data {};
+        _deferredRing->pop(data);
+        return data;
+    }
 #if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
     return uart_getc(_uart);
 #elif defined(FRAMEWORK_ESPIDF)
@@ -397,16 +549,52 @@ bool SerialPort::onDataReceivedFromISR(uint8_t data)
     return _watcher ? _watcher->onDataReceivedFromISR(data) : true;
 }
 
+/*!
+Counts the receive errors, errors is a combination of the UART_ERROR flags.
+*/
+FAST_CODE void SerialPort::onErrorFromISR(uint32_t errors)
+{
+    if (errors & UART_ERROR_OVERRUN) {
+        ++_errorCounts.overrunCount;
+    }
+    if (errors & UART_ERROR_FRAMING) {
+        ++_errorCounts.framingErrorCount;
+    }
+    if (errors & UART_ERROR_PARITY) {
+        ++_errorCounts.parityErrorCount;
+    }
+}
+
+/*!
+Called by the ISR for each received byte.
+
+In deferred mode pushes the byte into the deferred ring and returns true, so the reading task is signalled that there is data to parse.
+Otherwise gives the byte to the parser, and returns true once a packet is complete.
+*/
+FAST_CODE bool SerialPort::receiveByteFromISR(uint8_t data)
+{
+    if (_deferredRing) {
+        return _deferredRing->push(data);
+    }
+    return onDataReceivedFromISR(data);
+}
+
+/*!
+Changes the baudrate, reception continues at the new baudrate.
+*/
 uint32_t SerialPort::setBaudrate(uint32_t baudrate)
 {
     _baudrate = baudrate;
-#if defined(FRAMEWORK_RPI_PICO)
-    return uart_set_baudrate (_uart, baudrate);
+#if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+    return uart_set_baudrate(_uart, baudrate);
 #elif defined(FRAMEWORK_ESPIDF)
     return baudrate;
 #elif defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
+    // HAL_UART_DeInit() stops reception, so it is restarted after the UART is reinitialized
+    _receiving = false;
     HAL_UART_DeInit(&_uart);
     uartInit();
+    startReceive();
     return baudrate;
 #elif defined(FRAMEWORK_TEST)
     return baudrate;
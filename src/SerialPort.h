@@ -1,5 +1,8 @@
 #pragma once
 
+#include "ByteRing.h"
+#include "TaskSignal.h"
+
 #include <TimeMicroseconds.h>
 #include <array>
 
@@ -12,21 +15,6 @@
 #endif
 #endif
 
-#if defined(FRAMEWORK_USE_FREERTOS)
-
-#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
-#include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
-#else
-#if defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
-#include <STM32FreeRTOS.h>
-#endif
-#include <FreeRTOS.h>
-#include <queue.h>
-#endif
-
-#endif // FRAMEWORK_USE_FREERTOS
-
 #if defined(FRAMEWORK_RPI_PICO)
 #include <hardware/uart.h>
 #include <pico/mutex.h>
@@ -65,9 +53,24 @@ public:
 };
 
 
+/*!
+Serial port, there may be one SerialPort instance for each UART.
+
+Each instance registers itself, by UART index, in the `instances` table when it is initialized,
+so the interrupt service routines dispatch to the owning instance without searching the instances.
+On STM32 the UART index is first found from the HAL handle's UART registers, with a fixed chain of comparisons.
+The HAL_UART_RxCpltCallback and HAL_UART_ErrorCallback callbacks must call SerialPort::dataReadyISR(huart) and SerialPort::errorISR(huart).
+Defining LIBRARY_RECEIVER_DEFINE_UART_CALLBACKS makes SerialPort define these callbacks, this must not be used with the STM32duino core,
+which defines them itself.
+
+In deferred mode, set with setDeferredRing(), the ISR does not parse the received bytes, it just pushes them into the ring,
+and the bytes are parsed by the task that reads the SerialPort. On dual core processors this splits receiving from parsing across cores:
+call init() on the core that is to take the UART interrupt (the interrupt is enabled on the calling core on RP2040 and ESP32),
+and run the receiver task on the other core.
+*/
 class SerialPort {
 public:
-    enum uart_index_e : uint8_t { UART_INDEX_0, UART_INDEX_1, UART_INDEX_2, UART_INDEX_3, UART_INDEX_4, UART_INDEX_5, UART_INDEX_6, UART_INDEX_7 };
+    enum uart_index_e : uint8_t { UART_INDEX_0, UART_INDEX_1, UART_INDEX_2, UART_INDEX_3, UART_INDEX_4, UART_INDEX_5, UART_INDEX_6, UART_INDEX_7, UART_COUNT };
     enum parity_e { PARITY_NONE, PARITY_EVEN, PARITY_ODD };
     enum stop_bits_e { STOP_BITS_1 = 1, STOP_BITS_2 = 2 };
     enum data_bits_e { DATA_BITS_5 = 5, DATA_BITS_6 = 6, DATA_BITS_7 = 7, DATA_BITS_8 = 8, DATA_BITS_9 = 9};
@@ -113,10 +116,21 @@ public:
         port_pin_t rx;
         port_pin_t tx;
     };
+    // UART receive error flags, for onErrorFromISR()
+    static constexpr uint32_t UART_ERROR_OVERRUN = 0x01;
+    static constexpr uint32_t UART_ERROR_FRAMING = 0x02;
+    static constexpr uint32_t UART_ERROR_PARITY = 0x04;
+    //! counts of the receive errors reported by the UART hardware, currently reported on RP2040/RP2350 and STM32
+    struct uart_error_counts_t {
+        uint32_t overrunCount;
+        uint32_t framingErrorCount;
+        uint32_t parityErrorCount;
+    };
 public:
     SerialPort(const stm32_uart_pins_t& pins, uint8_t uartIndex, uint32_t baudrate, uint8_t dataBits, uint8_t stopBits, uint8_t parity);
     SerialPort(const uart_pins_t& pins, uint8_t uartIndex, uint32_t baudrate, uint8_t dataBits, uint8_t stopBits, uint8_t parity);
     SerialPort(SerialPortWatcherBase* watcher, const serial_pins_t& pins, uint8_t uartIndex, uint32_t baudrate, uint8_t dataBits, uint8_t stopBits, uint8_t parity);
+    ~SerialPort();
     void init();
     void uartInit();
 private:
@@ -134,20 +148,45 @@ public:
     void writeByte(uint8_t data);
     size_t write(const uint8_t* buf, size_t len);
     uint32_t setBaudrate(uint32_t baudrate);
+    uint32_t getBaudrate() const { return _baudrate; }
+    bool isReceiving() const { return _receiving; } //!< true once init() has started reception
+    uint8_t getUartIndex() const { return _uartIndex; }
+    void setDeferredRing(ByteRing* deferredRing) { _deferredRing = deferredRing; } //!< must be called before init()
+    bool isDeferred() const { return _deferredRing != nullptr; }
+    bool receiveByteFromISR(uint8_t data);
+    void onErrorFromISR(uint32_t errors);
+    const uart_error_counts_t& getErrorCounts() const { return _errorCounts; }
+    static SerialPort* getInstance(uint8_t uartIndex) { return uartIndex < UART_COUNT ? instances[uartIndex] : nullptr; }
 public:
-    static void dataReadyISR();
+    static void dataReadyISR(uint8_t uartIndex);
+#if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
+    // the RP2040 IRQ handlers take no arguments, so there is one handler for each UART
+    static void dataReadyISR_UART0();
+    static void dataReadyISR_UART1();
+#endif
 #if defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
     static void dataReadyISR(const UART_HandleTypeDef *huart);
+    static void errorISR(const UART_HandleTypeDef *huart);
+    static SerialPort* getInstance(const UART_HandleTypeDef *huart);
+#endif
+private:
+    void startReceive();
+    void dataReadyInstanceISR();
+#if defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
+    void errorInstanceISR();
 #endif
 private:
-    static SerialPort* self; //!< alias of `this` to be used in Interrupt Service Routine
+    static std::array<SerialPort*, UART_COUNT> instances; //!< instances indexed by UART index, to be used by the Interrupt Service Routines
     SerialPortWatcherBase* _watcher {nullptr};
+    ByteRing* _deferredRing {nullptr};
+    uart_error_counts_t _errorCounts {};
     const serial_pins_t _pins {};
     const uint8_t _uartIndex;
     const uint8_t _dataBits;
     const uint8_t _stopBits;
     const uint8_t _parity;
     uint32_t _baudrate;
+    bool _receiving {false};
 #if defined(FRAMEWORK_RPI_PICO) || defined(FRAMEWORK_ARDUINO_RPI_PICO)
     uart_inst_t* _uart {};
 #elif defined(FRAMEWORK_ESPIDF)
@@ -161,28 +200,11 @@ private:
 #endif
 #endif
 
-#if defined(FRAMEWORK_USE_FREERTOS)
-
-    uint32_t _dataReadyQueueItem {};
-    BaseType_t _dataReadyQueueHigherPriorityTaskWoken = pdFALSE;
-    enum { DATA_READY_QUEUE_LENGTH = 1 };
-    std::array<uint8_t, DATA_READY_QUEUE_LENGTH * sizeof(_dataReadyQueueItem)> _dataReadyQueueStorageArea {};
-    StaticQueue_t _dataReadyQueueStatic {};
-    QueueHandle_t _dataReadyQueue {};
+    TaskSignal _dataReady;
 public:
-    inline int32_t WAIT_DATA_READY(uint32_t ticksToWait) { return xQueueReceive(_dataReadyQueue, &_dataReadyQueueItem, ticksToWait); } // returns pdPASS(1) if queue read, pdFAIL(0) if timeout
-    inline void SIGNAL_DATA_READY_FROM_ISR() {
-        _dataReadyQueueHigherPriorityTaskWoken = pdFALSE;
-        xQueueOverwriteFromISR(_dataReadyQueue, &_dataReadyQueueItem, &_dataReadyQueueHigherPriorityTaskWoken);
-        portYIELD_FROM_ISR(_dataReadyQueueHigherPriorityTaskWoken); // cppcheck-suppress cstyleCast
-    }
-#else
-
-public:
-    inline int32_t WAIT_DATA_READY(uint32_t ticksToWait) { (void)ticksToWait; return 0; }
-    inline void SIGNAL_DATA_READY_FROM_ISR() {}
-
-#endif // FRAMEWORK_USE_FREERTOS
+    //! returns the number of packets completed since the last wait, 0 if timeout
+    inline int32_t WAIT_DATA_READY(uint32_t ticksToWait) { return _dataReady.WAIT(ticksToWait); }
+    inline void SIGNAL_DATA_READY_FROM_ISR() { _dataReady.SIGNAL_FROM_ISR(); }
 public:
     static constexpr std::array <uint32_t, BAUDRATE_COUNT> baudrates {
         0, 9600, 19200, 38400, 57600, 115200, 230400, 250000,
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(FRAMEWORK_USE_FREERTOS)
+
+#if defined(FRAMEWORK_ESPIDF) || defined(FRAMEWORK_ARDUINO_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#if defined(FRAMEWORK_STM32_CUBE) || defined(FRAMEWORK_ARDUINO_STM32)
+#include <STM32FreeRTOS.h>
+#endif
+#include <FreeRTOS.h>
+#include <task.h>
+#endif
+
+#elif defined(FRAMEWORK_TEST) || defined(__linux__)
+// same condition as RECEIVER_TASK_USE_STD_THREAD, so a ReceiverTask on a std::thread blocks in WAIT()
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#endif // FRAMEWORK_USE_FREERTOS
+
+#if defined(FRAMEWORK_USE_FREERTOS) && defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+#define TASK_SIGNAL_USE_NOTIFICATION_INDEX
+#endif
+
+
+/*!
+Signal used by an ISR (or callback) to wake the task waiting for data.
+
+With FreeRTOS this uses a direct to task notification as a counting semaphore,
+which is faster and uses less RAM than a queue. The waiting task is the task that last called WAIT().
+Signals sent before the task first calls WAIT() are lost, so the waiting task should call WAIT() before the data source is started.
+
+The notification count belongs to the task, not to the TaskSignal: all the TaskSignals a task waits on that have the same notification index
+add to the same count. So WAIT() returns the number of signals to that notification index since the last WAIT() on it returned,
+and where a task waits on more than one TaskSignal with the same index (for example the sources of a ReceiverDiversity,
+or the ESP-NOW primary and secondary signals) the caller must treat a non-zero return only as "at least one event".
+If FreeRTOS is configured with configTASK_NOTIFICATION_ARRAY_ENTRIES > 1, a TaskSignal may be given its own notification index,
+NOTIFICATION_INDEX_DATA is used by default.
+
+For native and Linux builds a mutex and condition variable are used, the count is per TaskSignal, and ticks are milliseconds.
+
+WAIT() returns the number of times SIGNAL_FROM_ISR() has been called since the last WAIT() returned, ie the number of frames completed,
+or 0 if it timed out.
+*/
+class TaskSignal {
+public:
+    enum { NOTIFICATION_INDEX_DATA = 0, NOTIFICATION_INDEX_PERIODIC = 1 };
+#if defined(FRAMEWORK_USE_FREERTOS)
+    static constexpr uint32_t WAIT_FOREVER = portMAX_DELAY;
+
+    TaskSignal() = default;
+    explicit TaskSignal(UBaseType_t notificationIndex) : _notificationIndex(notificationIndex) {}
+
+#if defined(TASK_SIGNAL_USE_NOTIFICATION_INDEX)
+    inline int32_t WAIT(uint32_t ticksToWait) {
+        _task = xTaskGetCurrentTaskHandle();
+        return static_cast<int32_t>(ulTaskNotifyTakeIndexed(_notificationIndex, pdTRUE, ticksToWait));
+    }
+    inline void SIGNAL_FROM_ISR() {
+        TaskHandle_t task = _task;
+        if (task != nullptr) {
+            BaseType_t higherPriorityTaskWoken = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR(task, _notificationIndex, &higherPriorityTaskWoken);
+            portYIELD_FROM_ISR(higherPriorityTaskWoken); // cppcheck-suppress cstyleCast
+        }
+    }
+    //! for signalling from task context, for example from an ESP32 esp_timer callback
+    inline void SIGNAL() {
+        TaskHandle_t task = _task;
+        if (task != nullptr) {
+            xTaskNotifyGiveIndexed(task, _notificationIndex);
+        }
+    }
+#else
+    // only notification index 0 is available, so all TaskSignals share it
+    inline int32_t WAIT(uint32_t ticksToWait) {
+        _task = xTaskGetCurrentTaskHandle();
+        return static_cast<int32_t>(ulTaskNotifyTake(pdTRUE, ticksToWait));
+    }
+    inline void SIGNAL_FROM_ISR() {
+        TaskHandle_t task = _task;
+        if (task != nullptr) {
+            BaseType_t higherPriorityTaskWoken = pdFALSE;
+            vTaskNotifyGiveFromISR(task, &higherPriorityTaskWoken);
+            portYIELD_FROM_ISR(higherPriorityTaskWoken); // cppcheck-suppress cstyleCast
+        }
+    }
+    //! for signalling from task context, for example from an ESP32 esp_timer callback
+    inline void SIGNAL() {
+        TaskHandle_t task = _task;
+        if (task != nullptr) {
+            xTaskNotifyGive(task);
+        }
+    }
+#endif
+private:
+    TaskHandle_t volatile _task {nullptr};
+    [[maybe_unused]] const UBaseType_t _notificationIndex {NOTIFICATION_INDEX_DATA};
+#elif defined(FRAMEWORK_TEST) || defined(__linux__)
+    static constexpr uint32_t WAIT_FOREVER = UINT32_MAX;
+
+    TaskSignal() = default;
+    explicit TaskSignal(uint32_t notificationIndex) { (void)notificationIndex; }
+
+    inline int32_t WAIT(uint32_t ticksToWait) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (ticksToWait == WAIT_FOREVER) {
+            _conditionVariable.wait(lock, [this]{ return _count != 0; });
+        } else if (!_conditionVariable.wait_for(lock, std::chrono::milliseconds(ticksToWait), [this]{ return _count != 0; })) {
+            return 0;
+        }
+        const uint32_t count = _count;
+        _count = 0;
+        return static_cast<int32_t>(count);
+    }
+    inline void SIGNAL_FROM_ISR() {
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            ++_count;
+        }
+        _conditionVariable.notify_one();
+    }
+    inline void SIGNAL() { SIGNAL_FROM_ISR(); }
+private:
+    std::mutex _mutex;
+    std::condition_variable _conditionVariable;
+    uint32_t _count {};
+#else
+    static constexpr uint32_t WAIT_FOREVER = UINT32_MAX;
+
+    TaskSignal() = default;
+    explicit TaskSignal(uint32_t notificationIndex) { (void)notificationIndex; }
+
+    inline int32_t WAIT(uint32_t ticksToWait) { (void)ticksToWait; return 0; }
+    inline void SIGNAL_FROM_ISR() {}
+    inline void SIGNAL() {}
+#endif // FRAMEWORK_USE_FREERTOS
+};
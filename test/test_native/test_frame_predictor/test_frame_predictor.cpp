@@ -0,0 +1,145 @@
+#include "FramePredictor.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+void test_frame_predictor_lock()
+{
+    FramePredictor predictor(1000);
+    TEST_ASSERT_FALSE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(0, predictor.getPeriodUs());
+
+    // frames every 4000us, but only seen to the nearest 1000us polling interval
+    timeUs32_t frameTimeUs = 10000;
+    for (uint32_t ii = 0; ii < FramePredictor::LOCK_FRAME_COUNT; ++ii) {
+        predictor.onFrame(frameTimeUs + (ii % 2) * 900);
+        frameTimeUs += 4000;
+        TEST_ASSERT_FALSE(predictor.isLocked());
+    }
+    predictor.onFrame(frameTimeUs);
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_GREATER_OR_EQUAL(3800, predictor.getPeriodUs());
+    TEST_ASSERT_LESS_OR_EQUAL(4200, predictor.getPeriodUs());
+    TEST_ASSERT_EQUAL(frameTimeUs + predictor.getPeriodUs(), predictor.getExpectedTimeUs());
+    TEST_ASSERT_EQUAL(predictor.getExpectedTimeUs() - predictor.getGuardUs(), predictor.getWakeTimeUs());
+    TEST_ASSERT_EQUAL(predictor.getExpectedTimeUs() + predictor.getGuardUs(), predictor.getDeadlineUs());
+    TEST_ASSERT_LESS_OR_EQUAL(predictor.getPeriodUs() / 2, predictor.getGuardUs());
+
+    // once locked, accurate frame times shrink the jitter and so the guard
+    const uint32_t guardUs = predictor.getGuardUs();
+    for (uint32_t ii = 0; ii < 50; ++ii) {
+        frameTimeUs = predictor.getExpectedTimeUs();
+        predictor.onFrame(frameTimeUs);
+    }
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_LESS_THAN(guardUs, predictor.getGuardUs());
+    TEST_ASSERT_GREATER_OR_EQUAL(FramePredictor::MIN_GUARD_US, predictor.getGuardUs());
+}
+
+void test_frame_predictor_miss()
+{
+    FramePredictor predictor(500);
+    timeUs32_t frameTimeUs = 0;
+    for (uint32_t ii = 0; ii <= FramePredictor::LOCK_FRAME_COUNT; ++ii) {
+        predictor.onFrame(frameTimeUs);
+        frameTimeUs += 5000;
+    }
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(5000, predictor.getPeriodUs());
+
+    // a missed frame moves the expected time on by one period
+    const timeUs32_t expectedTimeUs = predictor.getExpectedTimeUs();
+    predictor.onMiss();
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(1, predictor.getMissCount());
+    TEST_ASSERT_EQUAL(expectedTimeUs + 5000, predictor.getExpectedTimeUs());
+
+    // the following frame arrives two periods after the last one, which is consistent with the period
+    predictor.onFrame(expectedTimeUs + 5000);
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(5000, predictor.getPeriodUs());
+
+    // too many consecutive misses unlocks the predictor
+    for (uint32_t ii = 0; ii < FramePredictor::MAX_CONSECUTIVE_MISSES; ++ii) {
+        predictor.onMiss();
+    }
+    TEST_ASSERT_FALSE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(1 + FramePredictor::MAX_CONSECUTIVE_MISSES, predictor.getMissCount());
+    TEST_ASSERT_EQUAL(1, predictor.getUnlockCount());
+    TEST_ASSERT_EQUAL(0, predictor.getPeriodUs());
+}
+
+void test_frame_predictor_period_change()
+{
+    FramePredictor predictor(500);
+    timeUs32_t frameTimeUs = 0;
+    for (uint32_t ii = 0; ii <= FramePredictor::LOCK_FRAME_COUNT; ++ii) {
+        predictor.onFrame(frameTimeUs);
+        frameTimeUs += 4000;
+    }
+    TEST_ASSERT_TRUE(predictor.isLocked());
+
+    // a single late frame is ignored, and the phase is kept
+    predictor.onFrame(frameTimeUs + 1500);
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(1, predictor.getOutlierCount());
+    TEST_ASSERT_EQUAL(frameTimeUs + 4000, predictor.getExpectedTimeUs());
+    frameTimeUs += 4000;
+    predictor.onFrame(frameTimeUs);
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(4000, predictor.getPeriodUs());
+
+    // transmitter switches to a different packet rate, so the predictor relearns
+    for (uint32_t ii = 0; ii < FramePredictor::MAX_CONSECUTIVE_MISSES - 1; ++ii) {
+        frameTimeUs += 7000;
+        predictor.onFrame(frameTimeUs);
+        TEST_ASSERT_TRUE(predictor.isLocked());
+    }
+    frameTimeUs += 7000;
+    predictor.onFrame(frameTimeUs);
+    TEST_ASSERT_FALSE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(1, predictor.getUnlockCount());
+    for (uint32_t ii = 0; ii < FramePredictor::LOCK_FRAME_COUNT; ++ii) {
+        frameTimeUs += 7000;
+        predictor.onFrame(frameTimeUs);
+    }
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(7000, predictor.getPeriodUs());
+}
+
+void test_frame_predictor_no_lock_to_half_period()
+{
+    FramePredictor predictor(1000);
+    // first interval is short, because of a delayed poll, so every later interval is two learned periods
+    timeUs32_t frameTimeUs = 0;
+    predictor.onFrame(frameTimeUs);
+    frameTimeUs += 2000;
+    predictor.onFrame(frameTimeUs);
+    for (uint32_t ii = 0; ii < 2 * FramePredictor::LOCK_FRAME_COUNT; ++ii) {
+        frameTimeUs += 4000;
+        predictor.onFrame(frameTimeUs);
+    }
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_EQUAL(4000, predictor.getPeriodUs());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_frame_predictor_lock);
+    RUN_TEST(test_frame_predictor_miss);
+    RUN_TEST(test_frame_predictor_period_change);
+    RUN_TEST(test_frame_predictor_no_lock_to_half_period);
+
+    UNITY_END();
+}
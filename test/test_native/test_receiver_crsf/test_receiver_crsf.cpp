@@ -1,5 +1,7 @@
+#include "CRSF_ParameterServer.h"
 #include "ReceiverCRSF.h"
 
+#include <cstring>
 #include <unity.h>
 
 void setUp()
@@ -77,6 +79,193 @@ void test_receiver_bind_packet()
     TEST_ASSERT_EQUAL(PACKET_CRC, receiver.getReceivedCRC());
     TEST_ASSERT_EQUAL(PACKET_CRC, receiver.calculateCRC());
 }
+
+class ParameterWatcher : public CRSF_ParameterWatcher {
+public:
+    int32_t getParameterValue(size_t index) const override { return values[index]; }
+    void setParameterValue(size_t index, int32_t value) override { values[index] = value; }
+public:
+    std::array<int32_t, 8> values {};
+};
+
+static constexpr std::array<CRSF_ParameterServer::parameter_t, 4> parameters {{
+    { .parent = 0, .type = CRSF_ParameterServer::TYPE_FOLDER, .name = "Receiver", .options = nullptr, .units = nullptr, .min = 0, .max = 0, .defaultValue = 0, .decimalPoint = 0, .step = 0 },
+    { .parent = 1, .type = CRSF_ParameterServer::TYPE_TEXT_SELECTION, .name = "Throttle", .options = "Full;Positive half", .units = "", .min = 0, .max = 1, .defaultValue = 0, .decimalPoint = 0, .step = 0 },
+    { .parent = 1, .type = CRSF_ParameterServer::TYPE_UINT16, .name = "Timeout", .options = nullptr, .units = "ms", .min = 10, .max = 1000, .defaultValue = 100, .decimalPoint = 0, .step = 0 },
+    { .parent = 0, .type = CRSF_ParameterServer::TYPE_INFO, .name = "Info", .options = "a long piece of text that does not fit in a single chunk of a CRSF frame", .units = nullptr, .min = 0, .max = 0, .defaultValue = 0, .decimalPoint = 0, .step = 0 },
+}};
+
+// payload is sized for the largest frame, the final byte of the packet payload is the CRC
+using frame_payload_t = std::array<uint8_t, ReceiverCRSF::MAX_PACKET_SIZE - 4>;
+
+static size_t makeExtendedFrame(ReceiverCRSF::packet_u& packet, uint8_t type, const frame_payload_t& payload, size_t payloadLength)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(payload.size(), payloadLength);
+    packet.value.sync = ReceiverCRSF::CRSF_SYNC_BYTE;
+    packet.value.length = static_cast<uint8_t>(payloadLength + 2);
+    packet.value.type = type;
+    uint8_t crc = ReceiverCRSF::calculateCRC(0, type);
+    for (size_t ii = 0; ii < payloadLength; ++ii) {
+        packet.value.payload[ii] = payload[ii];
+        crc = ReceiverCRSF::calculateCRC(crc, payload[ii]);
+    }
+    packet.value.payload[payloadLength] = crc;
+    return payloadLength + 4;
+}
+
+static bool frameCRC_OK(const CRSF_ParameterServer::frame_t& frame, size_t length)
+{
+    uint8_t crc = 0;
+    for (size_t ii = 2; ii < length - 1; ++ii) {
+        crc = ReceiverCRSF::calculateCRC(crc, frame[ii]);
+    }
+    return crc == frame[length - 1] && frame[1] == length - 2;
+}
+
+void test_parameter_server_ping()
+{
+    static ParameterWatcher watcher;
+    static CRSF_ParameterServer server({ .name = "FC", .serialNumber = 0x12345678, .hardwareId = 1, .firmwareId = 2 }, &parameters[0], parameters.size(), &watcher);
+    CRSF_ParameterServer::frame_t response {};
+
+    const std::array<uint8_t, 2> ping { ReceiverCRSF::ADDRESS_BROADCAST, ReceiverCRSF::ADDRESS_RADIO_TRANSMITTER };
+    const size_t length = server.processFrame(ReceiverCRSF::FRAMETYPE_DEVICE_PING, &ping[0], ping.size(), response);
+    TEST_ASSERT_EQUAL(4 + 2 + 3 + 12 + 2, length);
+    TEST_ASSERT_TRUE(frameCRC_OK(response, length));
+    TEST_ASSERT_EQUAL(ReceiverCRSF::FRAMETYPE_DEVICE_INFO, response[2]);
+    TEST_ASSERT_EQUAL(ReceiverCRSF::ADDRESS_RADIO_TRANSMITTER, response[3]);
+    TEST_ASSERT_EQUAL(ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER, response[4]);
+    TEST_ASSERT_EQUAL('F', response[5]);
+    TEST_ASSERT_EQUAL('C', response[6]);
+    TEST_ASSERT_EQUAL(0, response[7]);
+    TEST_ASSERT_EQUAL(0x12, response[8]);
+    TEST_ASSERT_EQUAL(0x78, response[11]);
+    TEST_ASSERT_EQUAL(parameters.size(), response[20]);
+
+    // ping addressed to another device is not answered
+    const std::array<uint8_t, 2> pingOther { ReceiverCRSF::ADDRESS_GPS, ReceiverCRSF::ADDRESS_RADIO_TRANSMITTER };
+    TEST_ASSERT_EQUAL(0, server.processFrame(ReceiverCRSF::FRAMETYPE_DEVICE_PING, &pingOther[0], pingOther.size(), response));
+}
+
+void test_parameter_server_read_write()
+{
+    static ParameterWatcher watcher;
+    static CRSF_ParameterServer server({ .name = "FC", .serialNumber = 0, .hardwareId = 0, .firmwareId = 0 }, &parameters[0], parameters.size(), &watcher);
+    CRSF_ParameterServer::frame_t response {};
+
+    // folder lists its children
+    std::array<uint8_t, 4> read { ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER, ReceiverCRSF::ADDRESS_RADIO_TRANSMITTER, 1, 0 };
+    size_t length = server.processFrame(ReceiverCRSF::FRAMETYPE_PARAMETER_READ, &read[0], read.size(), response);
+    TEST_ASSERT_TRUE(frameCRC_OK(response, length));
+    TEST_ASSERT_EQUAL(ReceiverCRSF::FRAMETYPE_PARAMETER_SETTINGS_ENTRY, response[2]);
+    TEST_ASSERT_EQUAL(1, response[5]); // index
+    TEST_ASSERT_EQUAL(0, response[6]); // chunks remaining
+    TEST_ASSERT_EQUAL(0, response[7]); // parent
+    TEST_ASSERT_EQUAL(CRSF_ParameterServer::TYPE_FOLDER, response[8]);
+    TEST_ASSERT_EQUAL(0, std::strcmp("Receiver", reinterpret_cast<const char*>(&response[9])));
+    TEST_ASSERT_EQUAL(2, response[18]);
+    TEST_ASSERT_EQUAL(3, response[19]);
+    TEST_ASSERT_EQUAL(0xFF, response[20]);
+
+    // write a 16-bit value, the response is the updated entry
+    watcher.values[3] = 100;
+    const std::array<uint8_t, 5> write { ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER, ReceiverCRSF::ADDRESS_RADIO_TRANSMITTER, 3, 0x01, 0x2C };
+    length = server.processFrame(ReceiverCRSF::FRAMETYPE_PARAMETER_WRITE, &write[0], write.size(), response);
+    TEST_ASSERT_TRUE(frameCRC_OK(response, length));
+    TEST_ASSERT_EQUAL(300, watcher.values[3]);
+    TEST_ASSERT_EQUAL(0, std::strcmp("Timeout", reinterpret_cast<const char*>(&response[9])));
+    TEST_ASSERT_EQUAL(0x01, response[17]);
+    TEST_ASSERT_EQUAL(0x2C, response[18]);
+
+    // long entry is split into chunks
+    read[2] = 4;
+    length = server.processFrame(ReceiverCRSF::FRAMETYPE_PARAMETER_READ, &read[0], read.size(), response);
+    TEST_ASSERT_EQUAL(CRSF_ParameterServer::MAX_FRAME_SIZE, length);
+    TEST_ASSERT_EQUAL(1, response[6]); // one chunk remaining
+    read[3] = 1;
+    length = server.processFrame(ReceiverCRSF::FRAMETYPE_PARAMETER_READ, &read[0], read.size(), response);
+    TEST_ASSERT_TRUE(frameCRC_OK(response, length));
+    TEST_ASSERT_EQUAL(0, response[6]);
+    TEST_ASSERT_EQUAL(0, response[length - 2]); // zero terminator of text
+    read[3] = 2;
+    TEST_ASSERT_EQUAL(0, server.processFrame(ReceiverCRSF::FRAMETYPE_PARAMETER_READ, &read[0], read.size(), response));
+}
+
+void test_receiver_parameter_write()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, 0, ReceiverCRSF::DATA_BITS, ReceiverCRSF::STOP_BITS, ReceiverCRSF::PARITY);
+    static ReceiverCRSF receiver(serialPort);
+    static ParameterWatcher watcher;
+    static CRSF_ParameterServer server({ .name = "FC", .serialNumber = 0, .hardwareId = 0, .firmwareId = 0 }, &parameters[0], parameters.size(), &watcher);
+    receiver.setParameterServer(&server);
+
+    ReceiverCRSF::packet_u packet {};
+    const size_t length = makeExtendedFrame(packet, ReceiverCRSF::FRAMETYPE_PARAMETER_WRITE, { ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER, ReceiverCRSF::ADDRESS_RADIO_TRANSMITTER, 2, 1 }, 4);
+    bool packetComplete = false;
+    for (size_t ii = 0; ii < length; ++ii) {
+        packetComplete = receiver.onDataReceivedFromISR(packet.data[ii]);
+    }
+    TEST_ASSERT_TRUE(packetComplete);
+    TEST_ASSERT_FALSE(receiver.isPacketEmpty());
+    // parameter frames do not produce new RC data
+    TEST_ASSERT_FALSE(receiver.update(0));
+    TEST_ASSERT_EQUAL(1, watcher.values[2]);
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+}
+
+class FrameTimingWatcher : public ReceiverFrameTimingWatcher {
+public:
+    void onFrameTiming(timeUs32_t expectedFrameTimeUs, uint32_t framePeriodUs, int32_t phaseOffsetUs) override {
+        (void)expectedFrameTimeUs;
+        period = framePeriodUs;
+        offset = phaseOffsetUs;
+        ++callCount;
+    }
+public:
+    uint32_t period {};
+    int32_t offset {};
+    int callCount {};
+};
+
+void test_receiver_opentx_sync()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, 0, ReceiverCRSF::DATA_BITS, ReceiverCRSF::STOP_BITS, ReceiverCRSF::PARITY);
+    static ReceiverCRSF receiver(serialPort);
+    static FrameTimingWatcher watcher;
+    receiver.setFrameTimingWatcher(&watcher);
+    TEST_ASSERT_FALSE(receiver.isSyncReceived());
+    TEST_ASSERT_EQUAL(0, receiver.getFramePeriodUs());
+
+    // rate of 4000us (250Hz) and offset of -120us, in units of 0.1us
+    const int32_t offset = -1200;
+    const auto offsetU = static_cast<uint32_t>(offset);
+    ReceiverCRSF::packet_u packet {};
+    const size_t length = makeExtendedFrame(packet, ReceiverCRSF::FRAMETYPE_RADIO_ID, {
+        ReceiverCRSF::ADDRESS_FLIGHT_CONTROLLER, ReceiverCRSF::ADDRESS_CRSF_TRANSMITTER, ReceiverCRSF::RADIO_ID_SUBTYPE_OPENTX_SYNC,
+        0x00, 0x00, 0x9C, 0x40,
+        static_cast<uint8_t>(offsetU >> 24U), static_cast<uint8_t>(offsetU >> 16U), static_cast<uint8_t>(offsetU >> 8U), static_cast<uint8_t>(offsetU)
+    }, ReceiverCRSF::OPENTX_SYNC_PAYLOAD_SIZE);
+    for (size_t ii = 0; ii < length; ++ii) {
+        receiver.onDataReceivedFromISR(packet.data[ii]);
+    }
+    TEST_ASSERT_FALSE(receiver.update(0));
+    TEST_ASSERT_TRUE(receiver.isSyncReceived());
+    TEST_ASSERT_EQUAL(4000, receiver.getFramePeriodUs());
+    TEST_ASSERT_EQUAL(-120, receiver.getPhaseOffsetUs());
+    // no RC frame received yet, so no expected frame time
+    TEST_ASSERT_EQUAL(0, watcher.callCount);
+
+    // RC frame gives the expected time of the next frame
+    const size_t rcLength = makeExtendedFrame(packet, ReceiverCRSF::FRAMETYPE_RC_CHANNELS_PACKED, {}, sizeof(ReceiverCRSF::rc_channels_packed_t));
+    for (size_t ii = 0; ii < rcLength; ++ii) {
+        receiver.onDataReceivedFromISR(packet.data[ii]);
+    }
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(1, watcher.callCount);
+    TEST_ASSERT_EQUAL(4000, watcher.period);
+    TEST_ASSERT_EQUAL(-120, watcher.offset);
+    TEST_ASSERT_EQUAL(receiver.getFrameTimeUs() + 4000, receiver.getExpectedFrameTimeUs());
+}
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
@@ -84,6 +273,10 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(test_receiver_crsf);
+    RUN_TEST(test_parameter_server_ping);
+    RUN_TEST(test_parameter_server_read_write);
+    RUN_TEST(test_receiver_parameter_write);
+    RUN_TEST(test_receiver_opentx_sync);
 
     UNITY_END();
 }
@@ -0,0 +1,149 @@
+#include "ReceiverDiversity.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class ReceiverTest : public ReceiverBase {
+public:
+    ReceiverTest() { _auxiliaryChannelCount = 4; }
+    virtual int32_t WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) override { (void)ticksToWait; return _frameReady ? 1 : 0; }
+    virtual bool update(uint32_t tickCountDelta) override { (void)tickCountDelta; const bool ret = _frameReady; _frameReady = false; return ret; }
+    virtual bool unpackPacket() override { return true; }
+    virtual void getStickValues(float& throttleStick, float& rollStick, float& pitchStick, float& yawStick) const override {
+        throttleStick = _throttle; rollStick = 0.0F; pitchStick = 0.0F; yawStick = 0.0F;
+    }
+    virtual uint16_t getChannelPWM(size_t index) const override { return static_cast<uint16_t>(_pwm + index); }
+    void receiveFrame(uint16_t pwm) { _pwm = pwm; _throttle = static_cast<float>(pwm) / 1000.0F; _frameReady = true; }
+private:
+    bool _frameReady {false};
+    uint16_t _pwm {};
+    float _throttle {};
+};
+
+void test_receiver_diversity_failover()
+{
+    ReceiverTest primary;
+    ReceiverTest secondary;
+    ReceiverDiversity receiver(primary, secondary);
+    TEST_ASSERT_EQUAL(2, receiver.getSourceCount());
+    TEST_ASSERT_EQUAL(ReceiverDiversity::NO_SOURCE, receiver.getActiveSource());
+    TEST_ASSERT_FALSE(receiver.update(0, 0));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(0));
+
+    enum { PERIOD = 4000 };
+    timeUs32_t timeUs = 100000;
+    // both sources receive frames, primary becomes active
+    for (size_t ii = 0; ii < 20; ++ii) {
+        primary.receiveFrame(1100);
+        secondary.receiveFrame(1200);
+        TEST_ASSERT_TRUE(receiver.update(1, timeUs));
+        timeUs += PERIOD;
+    }
+    TEST_ASSERT_EQUAL(0, receiver.getActiveSource());
+    TEST_ASSERT_EQUAL(1, receiver.getSourceSwitchCount());
+    TEST_ASSERT_EQUAL(PERIOD, receiver.getFramePeriodUs(0));
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(0));
+    TEST_ASSERT_EQUAL(1102, receiver.getChannelPWM(2));
+    float throttle {};
+    float roll {};
+    float pitch {};
+    float yaw {};
+    receiver.getStickValues(throttle, roll, pitch, yaw);
+    TEST_ASSERT_EQUAL_FLOAT(1.1F, throttle);
+    TEST_ASSERT_EQUAL(20, receiver.getPacketCount());
+
+    // primary misses one frame: no new frame, but still within 1.5 frame periods
+    secondary.receiveFrame(1200);
+    TEST_ASSERT_FALSE(receiver.update(1, timeUs));
+    TEST_ASSERT_EQUAL(0, receiver.getActiveSource());
+    timeUs += PERIOD;
+
+    // primary misses second frame, so fail over to secondary within one frame period
+    secondary.receiveFrame(1200);
+    TEST_ASSERT_TRUE(receiver.update(1, timeUs));
+    TEST_ASSERT_EQUAL(1, receiver.getActiveSource());
+    TEST_ASSERT_EQUAL(1200, receiver.getChannelPWM(0));
+    timeUs += PERIOD;
+    for (size_t ii = 0; ii < 10; ++ii) {
+        secondary.receiveFrame(1200);
+        TEST_ASSERT_TRUE(receiver.update(1, timeUs));
+        timeUs += PERIOD;
+    }
+
+    // primary recovers: its link quality has dropped, so secondary stays active (hysteresis)
+    TEST_ASSERT_LESS_THAN(receiver.getLinkQuality(1), receiver.getLinkQuality(0));
+    primary.receiveFrame(1100);
+    secondary.receiveFrame(1200);
+    TEST_ASSERT_TRUE(receiver.update(1, timeUs));
+    TEST_ASSERT_EQUAL(1, receiver.getActiveSource());
+    TEST_ASSERT_EQUAL(1200, receiver.getChannelPWM(0));
+    timeUs += PERIOD;
+
+    // secondary starts losing every other frame, so its link quality drops and eventually primary takes over
+    size_t switchedAt = 0;
+    for (size_t ii = 0; ii < 100 && switchedAt == 0; ++ii) {
+        primary.receiveFrame(1100);
+        if (ii % 2 == 0) {
+            secondary.receiveFrame(1200);
+        }
+        receiver.update(1, timeUs);
+        if (receiver.getActiveSource() == 0) {
+            switchedAt = ii;
+        }
+        timeUs += PERIOD;
+    }
+    TEST_ASSERT_GREATER_THAN(0, switchedAt);
+    TEST_ASSERT_EQUAL(0, receiver.getActiveSource());
+    TEST_ASSERT_EQUAL(3, receiver.getSourceSwitchCount());
+    TEST_ASSERT_GREATER_THAN(receiver.getLinkQuality(1) + ReceiverDiversity::LINK_QUALITY_HYSTERESIS_PERCENT - 1, receiver.getLinkQuality(0));
+}
+
+void test_receiver_diversity_both_lost()
+{
+    ReceiverTest primary;
+    ReceiverTest secondary;
+    ReceiverTest third;
+    ReceiverDiversity receiver;
+    TEST_ASSERT_TRUE(receiver.addReceiver(primary));
+    TEST_ASSERT_TRUE(receiver.addReceiver(secondary));
+    TEST_ASSERT_TRUE(receiver.addReceiver(third));
+    TEST_ASSERT_TRUE(receiver.addReceiver(third));
+    TEST_ASSERT_FALSE(receiver.addReceiver(third));
+
+    // only the secondary receives frames, so it is selected
+    secondary.receiveFrame(1300);
+    TEST_ASSERT_TRUE(receiver.update(1, 1000));
+    TEST_ASSERT_EQUAL(1, receiver.getActiveSource());
+    TEST_ASSERT_EQUAL(0, receiver.WAIT_FOR_DATA_RECEIVED(0));
+    // data on a source other than the active source is also detected
+    primary.receiveFrame(1100);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(5));
+    // primary frame does not cause a switch, since secondary is still healthy
+    TEST_ASSERT_FALSE(receiver.update(1, 2000));
+    TEST_ASSERT_EQUAL(1, receiver.getActiveSource());
+
+    // all sources lost: active source is kept, and no frames are reported, so failsafe is handled by the cockpit
+    TEST_ASSERT_FALSE(receiver.update(1, 500000));
+    TEST_ASSERT_FALSE(receiver.isSourceHealthy(0, 500000));
+    TEST_ASSERT_FALSE(receiver.isSourceHealthy(1, 500000));
+    TEST_ASSERT_NOT_EQUAL(ReceiverDiversity::NO_SOURCE, receiver.getActiveSource());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_diversity_failover);
+    RUN_TEST(test_receiver_diversity_both_lost);
+
+    UNITY_END();
+}
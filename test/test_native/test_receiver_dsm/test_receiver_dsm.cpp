@@ -0,0 +1,145 @@
+#include "ReceiverDSM.h"
+
+#include <chrono>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+typedef std::array<uint8_t, ReceiverDSM::FRAME_SIZE> frame_t;
+typedef std::array<uint16_t, ReceiverDSM::CHANNEL_WORD_COUNT> words_t;
+
+static frame_t makeFrame(uint8_t system, const words_t& words)
+{
+    frame_t frame {};
+    frame[0] = 0; // fade count
+    frame[1] = system;
+    for (size_t ii = 0; ii < words.size(); ++ii) {
+        frame[2 + 2*ii] = static_cast<uint8_t>(words[ii] >> 8U);
+        frame[3 + 2*ii] = static_cast<uint8_t>(words[ii]);
+    }
+    return frame;
+}
+
+static uint16_t word11(uint16_t id, uint16_t value)
+{
+    return static_cast<uint16_t>((id << 11U) | value);
+}
+
+static uint16_t word10(uint16_t id, uint16_t value)
+{
+    return static_cast<uint16_t>((id << 10U) | value);
+}
+
+static bool sendFrame(ReceiverDSM& receiver, const frame_t& frame)
+{
+    bool complete = false;
+    for (uint8_t data : frame) {
+        complete = receiver.onDataReceivedFromISR(data);
+    }
+    return complete;
+}
+
+void test_receiver_dsm_11_bit()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverDSM::BAUD_RATE, ReceiverDSM::DATA_BITS, ReceiverDSM::STOP_BITS, ReceiverDSM::PARITY);
+    static ReceiverDSM receiver(serialPort);
+
+    // 12 channels over two frames, channel 0 is throttle, 1 is roll, 2 is pitch, 3 is yaw
+    const frame_t frameA = makeFrame(ReceiverDSM::SYSTEM_DSMX_2048_11MS, words_t {
+        word11(0, 2047), word11(1, 1024), word11(2, 0), word11(3, 1024), word11(4, 1040), word11(5, 1050), word11(6, 1060)
+    });
+    const frame_t frameB = makeFrame(ReceiverDSM::SYSTEM_DSMX_2048_11MS, words_t {
+        static_cast<uint16_t>(0x8000U | word11(7, 1070)), word11(8, 1080), word11(9, 1090), word11(10, 1100), word11(11, 1110),
+        ReceiverDSM::UNUSED_CHANNEL_WORD, ReceiverDSM::UNUSED_CHANNEL_WORD
+    });
+
+    TEST_ASSERT_EQUAL(ReceiverDSM::RESOLUTION_UNKNOWN, receiver.getResolution());
+    for (size_t ii = 0; ii < ReceiverDSM::DETECTION_FRAME_COUNT; ++ii) {
+        TEST_ASSERT_TRUE(sendFrame(receiver, (ii & 1U) ? frameB : frameA));
+        TEST_ASSERT_FALSE(receiver.unpackPacket());
+    }
+    TEST_ASSERT_EQUAL(ReceiverDSM::RESOLUTION_11_BIT, receiver.getResolution());
+    TEST_ASSERT_EQUAL_HEX16(0x0FFF, receiver.getChannelMask());
+
+    // first frame of the set is not a complete channel set
+    sendFrame(receiver, frameB);
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    sendFrame(receiver, frameA);
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+
+    TEST_ASSERT_EQUAL(2011, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(1508, receiver.getChannelPWM(ReceiverBase::AUX1));
+    TEST_ASSERT_EQUAL(1523, receiver.getChannelPWM(ReceiverBase::AUX4));
+    TEST_ASSERT_EQUAL(1543, receiver.getChannelPWM(ReceiverBase::AUX8));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(ReceiverDSM::CHANNEL_COUNT));
+
+    sendFrame(receiver, frameB);
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    sendFrame(receiver, frameA);
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+}
+
+void test_receiver_dsm_10_bit()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverDSM::BAUD_RATE, ReceiverDSM::DATA_BITS, ReceiverDSM::STOP_BITS, ReceiverDSM::PARITY);
+    static ReceiverDSM receiver(serialPort);
+
+    // 7 channels in a single frame
+    const frame_t frame = makeFrame(ReceiverDSM::SYSTEM_DSM2_1024_22MS, words_t {
+        word10(0, 12), word10(1, 512), word10(2, 1000), word10(3, 600), word10(4, 0), word10(5, 1023), word10(6, 512)
+    });
+    for (size_t ii = 0; ii < ReceiverDSM::DETECTION_FRAME_COUNT; ++ii) {
+        sendFrame(receiver, frame);
+        TEST_ASSERT_FALSE(receiver.unpackPacket());
+    }
+    TEST_ASSERT_EQUAL(ReceiverDSM::RESOLUTION_10_BIT, receiver.getResolution());
+    TEST_ASSERT_EQUAL_HEX16(0x007F, receiver.getChannelMask());
+
+    sendFrame(receiver, frame);
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1988, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1588, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::AUX1));
+    TEST_ASSERT_EQUAL(2011, receiver.getChannelPWM(ReceiverBase::AUX2));
+
+    float throttle {};
+    float roll {};
+    float pitch {};
+    float yaw {};
+    receiver.getStickValues(throttle, roll, pitch, yaw);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, throttle);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, roll);
+
+    // partial frame followed by gap is discarded
+    for (size_t ii = 0; ii < 8; ++ii) {
+        receiver.onDataReceivedFromISR(frame[ii]);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(ReceiverDSM::TIME_NEEDED_PER_FRAME_US + 1000));
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_dsm_11_bit);
+    RUN_TEST(test_receiver_dsm_10_bit);
+
+    UNITY_END();
+}
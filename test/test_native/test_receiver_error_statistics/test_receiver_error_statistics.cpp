@@ -0,0 +1,185 @@
+#include "ReceiverCRSF.h"
+#include "ReceiverSBUS.h"
+#include "ReceiverSnapshot.h"
+#include "ReceiverTelemetry.h"
+#include "ReceiverTelemetryData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+/*!
+Makes a CRSF RC channels frame, with all channels at mid range.
+*/
+static std::array<uint8_t, 26> makeChannelsFrame()
+{
+    enum { CHANNEL_COUNT = 16, CRSF_MID = 992 };
+    std::array<uint8_t, 26> frame {};
+    std::array<uint8_t, 22> payload {};
+    uint32_t bitIndex = 0;
+    for (size_t ii = 0; ii < CHANNEL_COUNT; ++ii) {
+        for (uint32_t bit = 0; bit < 11; ++bit, ++bitIndex) {
+            if (CRSF_MID & (1U << bit)) {
+                payload[bitIndex / 8] |= static_cast<uint8_t>(1U << (bitIndex % 8));
+            }
+        }
+    }
+    frame[0] = ReceiverCRSF::CRSF_SYNC_BYTE;
+    frame[1] = 24;
+    frame[2] = ReceiverCRSF::FRAMETYPE_RC_CHANNELS_PACKED;
+    uint8_t crc = ReceiverCRSF::calculateCRC(0, frame[2]);
+    for (size_t ii = 0; ii < payload.size(); ++ii) {
+        frame[3 + ii] = payload[ii];
+        crc = ReceiverCRSF::calculateCRC(crc, payload[ii]);
+    }
+    frame[25] = crc;
+    return frame;
+}
+
+template <size_t N>
+static bool sendBytes(ReceiverBase& receiver, const std::array<uint8_t, N>& bytes, size_t count = N)
+{
+    bool completed = false;
+    for (size_t ii = 0; ii < std::min(count, N); ++ii) {
+        completed = receiver.onDataReceivedFromISR(bytes[ii]);
+    }
+    return completed;
+}
+
+static void idleGap(uint32_t frameTimeUs)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(frameTimeUs + 1000));
+}
+
+void test_receiver_error_statistics_crsf()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, 0, ReceiverCRSF::DATA_BITS, ReceiverCRSF::STOP_BITS, ReceiverCRSF::PARITY);
+    static ReceiverCRSF receiver(serialPort);
+    const std::array<uint8_t, 26> frame = makeChannelsFrame();
+
+    // an idle gap between complete frames is not an error
+    TEST_ASSERT_TRUE(sendBytes(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    idleGap(ReceiverCRSF::TIME_NEEDED_PER_FRAME_US);
+    TEST_ASSERT_TRUE(sendBytes(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    ReceiverBase::error_statistics_t errorStatistics = receiver.getErrorStatistics();
+    TEST_ASSERT_EQUAL(0, receiver.getDroppedPacketCount());
+    TEST_ASSERT_EQUAL(0, errorStatistics.truncatedFrameCount);
+    TEST_ASSERT_EQUAL(0, errorStatistics.discardedByteCount);
+
+    // a frame that stops part way through is dropped when the timeout expires
+    idleGap(ReceiverCRSF::TIME_NEEDED_PER_FRAME_US);
+    TEST_ASSERT_FALSE(sendBytes(receiver, frame, 10));
+    idleGap(ReceiverCRSF::TIME_NEEDED_PER_FRAME_US);
+    TEST_ASSERT_TRUE(sendBytes(receiver, frame));
+    errorStatistics = receiver.getErrorStatistics();
+    TEST_ASSERT_EQUAL(1, receiver.getDroppedPacketCount());
+    TEST_ASSERT_EQUAL(1, errorStatistics.truncatedFrameCount);
+    TEST_ASSERT_EQUAL(10, errorStatistics.discardedByteCount);
+    TEST_ASSERT_EQUAL(0, errorStatistics.badSyncByteCount);
+
+    // bytes that are not sync bytes are discarded, and the next frame is a resync
+    idleGap(ReceiverCRSF::TIME_NEEDED_PER_FRAME_US);
+    const std::array<uint8_t, 3> noise { 0x00, 0x55, 0xAA };
+    TEST_ASSERT_FALSE(sendBytes(receiver, noise));
+    errorStatistics = receiver.getErrorStatistics();
+    TEST_ASSERT_EQUAL(3, errorStatistics.badSyncByteCount);
+    TEST_ASSERT_EQUAL(13, errorStatistics.discardedByteCount);
+    TEST_ASSERT_EQUAL(0, errorStatistics.resyncCount);
+    TEST_ASSERT_TRUE(sendBytes(receiver, frame));
+    TEST_ASSERT_EQUAL(1, receiver.getErrorStatistics().resyncCount);
+    TEST_ASSERT_TRUE(receiver.update(0));
+
+    // a frame with a bad CRC is received, but rejected when it is unpacked
+    idleGap(ReceiverCRSF::TIME_NEEDED_PER_FRAME_US);
+    std::array<uint8_t, 26> badFrame = frame;
+    badFrame[10] ^= 0x01U;
+    TEST_ASSERT_TRUE(sendBytes(receiver, badFrame));
+    TEST_ASSERT_FALSE(receiver.update(0));
+    errorStatistics = receiver.getErrorStatistics();
+    TEST_ASSERT_EQUAL(1, errorStatistics.crcErrorCount);
+    TEST_ASSERT_EQUAL(1, receiver.getDroppedPacketCount());
+    TEST_ASSERT_EQUAL(1, errorStatistics.resyncCount);
+}
+
+void test_receiver_error_statistics_sbus()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 1, 0, ReceiverSBUS::DATA_BITS, ReceiverSBUS::STOP_BITS, ReceiverSBUS::PARITY);
+    static ReceiverSBUS receiver(serialPort);
+    enum { PACKET_SIZE = 25 };
+    std::array<uint8_t, PACKET_SIZE> frame {};
+    frame[0] = ReceiverSBUS::SBUS_START_BYTE;
+    frame[PACKET_SIZE - 1] = ReceiverSBUS::SBUS_END_BYTE;
+    TEST_ASSERT_TRUE(sendBytes(receiver, frame));
+
+    // SBUS has no CRC, so a bad end byte means the frame was out of sync and the whole frame is discarded
+    idleGap(ReceiverSBUS::TIME_NEEDED_PER_FRAME_US);
+    frame[PACKET_SIZE - 1] = 0x55;
+    TEST_ASSERT_FALSE(sendBytes(receiver, frame));
+    ReceiverBase::error_statistics_t errorStatistics = receiver.getErrorStatistics();
+    TEST_ASSERT_EQUAL(1, errorStatistics.badSyncByteCount);
+    TEST_ASSERT_EQUAL(PACKET_SIZE, errorStatistics.discardedByteCount);
+    TEST_ASSERT_EQUAL(0, receiver.getPacketIndex());
+    TEST_ASSERT_EQUAL(0, receiver.getDroppedPacketCount());
+
+    idleGap(ReceiverSBUS::TIME_NEEDED_PER_FRAME_US);
+    frame[PACKET_SIZE - 1] = ReceiverSBUS::SBUS_END_BYTE;
+    TEST_ASSERT_TRUE(sendBytes(receiver, frame));
+    TEST_ASSERT_EQUAL(1, receiver.getErrorStatistics().resyncCount);
+}
+
+void test_receiver_error_statistics_uart()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 2, 0, ReceiverCRSF::DATA_BITS, ReceiverCRSF::STOP_BITS, ReceiverCRSF::PARITY);
+    static ReceiverCRSF receiver(serialPort);
+
+    serialPort.onErrorFromISR(SerialPort::UART_ERROR_OVERRUN | SerialPort::UART_ERROR_FRAMING);
+    serialPort.onErrorFromISR(SerialPort::UART_ERROR_FRAMING);
+    serialPort.onErrorFromISR(SerialPort::UART_ERROR_PARITY);
+    TEST_ASSERT_EQUAL(1, serialPort.getErrorCounts().overrunCount);
+
+    const ReceiverBase::error_statistics_t errorStatistics = receiver.getErrorStatistics();
+    TEST_ASSERT_EQUAL(1, errorStatistics.uartOverrunCount);
+    TEST_ASSERT_EQUAL(2, errorStatistics.uartFramingErrorCount);
+    TEST_ASSERT_EQUAL(1, errorStatistics.uartParityErrorCount);
+
+    // the error statistics are included in the snapshot and in telemetry
+    receiver_snapshot_t snapshot {};
+    makeReceiverSnapshot(snapshot, receiver, 1, 0);
+    TEST_ASSERT_EQUAL(2, snapshot.errorStatistics.uartFramingErrorCount);
+
+    std::array<uint8_t, 64> buf {};
+    const size_t len = packTelemetryData_ReceiverErrors(&buf[0], 0x1234, 3, receiver);
+    TEST_ASSERT_EQUAL(sizeof(TD_RECEIVER_ERRORS), len);
+    const auto* td = reinterpret_cast<const TD_RECEIVER_ERRORS*>(&buf[0]); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    TEST_ASSERT_EQUAL(0x1234, td->id);
+    TEST_ASSERT_EQUAL(TD_RECEIVER::TYPE, td->type);
+    TEST_ASSERT_EQUAL(TD_RECEIVER_ERRORS::SUB_TYPE, td->subType);
+    TEST_ASSERT_EQUAL(3, td->sequenceNumber);
+    TEST_ASSERT_EQUAL(1, td->errorStatistics.uartOverrunCount);
+    TEST_ASSERT_EQUAL(1, td->errorStatistics.uartParityErrorCount);
+    TEST_ASSERT_EQUAL(0, td->errorStatistics.crcErrorCount);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_error_statistics_crsf);
+    RUN_TEST(test_receiver_error_statistics_sbus);
+    RUN_TEST(test_receiver_error_statistics_uart);
+
+    UNITY_END();
+}
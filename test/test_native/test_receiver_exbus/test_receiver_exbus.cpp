@@ -0,0 +1,168 @@
+#include "ReceiverEXBUS.h"
+
+#include <chrono>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+typedef std::array<uint8_t, ReceiverEXBUS::MAX_PACKET_SIZE> packet_t;
+
+// returns length of packet
+static size_t makePacket(packet_t& packet, uint8_t header, uint8_t header2, uint8_t packetId, uint8_t dataId, const uint8_t* data, size_t dataLength)
+{
+    size_t pos = 0;
+    packet[pos++] = header;
+    packet[pos++] = header2;
+    packet[pos++] = static_cast<uint8_t>(ReceiverEXBUS::HEADER_SIZE + dataLength + ReceiverEXBUS::CRC_SIZE);
+    packet[pos++] = packetId;
+    packet[pos++] = dataId;
+    packet[pos++] = static_cast<uint8_t>(dataLength);
+    for (size_t ii = 0; ii < dataLength; ++ii) {
+        packet[pos++] = data[ii];
+    }
+    const uint16_t crc = ReceiverEXBUS::calculateCRC(&packet[0], pos);
+    packet[pos++] = static_cast<uint8_t>(crc);
+    packet[pos++] = static_cast<uint8_t>(crc >> 8U);
+    return pos;
+}
+
+static bool sendPacket(ReceiverEXBUS& receiver, const packet_t& packet, size_t length)
+{
+    bool complete = false;
+    for (size_t ii = 0; ii < length; ++ii) {
+        complete = receiver.onDataReceivedFromISR(packet[ii]);
+    }
+    return complete;
+}
+
+void test_receiver_exbus_crc()
+{
+    // reflected CRC16-CCITT (KERMIT) check value
+    const std::array<uint8_t, 9> data = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x2189, ReceiverEXBUS::calculateCRC(&data[0], data.size()));
+}
+
+void test_receiver_exbus_channels()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverEXBUS::BAUD_RATE, ReceiverEXBUS::DATA_BITS, ReceiverEXBUS::STOP_BITS, ReceiverEXBUS::PARITY);
+    static ReceiverEXBUS receiver(serialPort);
+
+    // 6 channels, 1100, 1500, 1000, 1900, 2000, 1250 microseconds
+    std::array<uint8_t, 12> channels {};
+    const std::array<uint16_t, 6> values = { 1100, 1500, 1000, 1900, 2000, 1250 };
+    for (size_t ii = 0; ii < values.size(); ++ii) {
+        channels[2*ii] = static_cast<uint8_t>(values[ii] * 8U);
+        channels[2*ii + 1] = static_cast<uint8_t>((values[ii] * 8U) >> 8U);
+    }
+    packet_t packet {};
+    size_t length = makePacket(packet, ReceiverEXBUS::HEADER_NO_REPLY, ReceiverEXBUS::HEADER2_CHANNEL_DATA, 0x12, ReceiverEXBUS::DATA_ID_CHANNEL, &channels[0], channels.size());
+    TEST_ASSERT_TRUE(sendPacket(receiver, packet, length));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1900, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(2000, receiver.getChannelPWM(ReceiverBase::AUX1));
+    TEST_ASSERT_EQUAL(1250, receiver.getChannelPWM(ReceiverBase::AUX2));
+    TEST_ASSERT_EQUAL(0, receiver.getChannelPWM(ReceiverBase::AUX3));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(ReceiverEXBUS::CHANNEL_COUNT));
+
+    // bad CRC
+    packet[length - 1] ^= 0x01;
+    TEST_ASSERT_TRUE(sendPacket(receiver, packet, length));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1, receiver.getErrorStatistics().crcErrorCount);
+
+    // data length longer than the packet, with a good CRC, is a truncated frame, not a CRC error
+    packet[5] = static_cast<uint8_t>(channels.size() + 2);
+    const uint16_t crc = ReceiverEXBUS::calculateCRC(&packet[0], length - ReceiverEXBUS::CRC_SIZE);
+    packet[length - 2] = static_cast<uint8_t>(crc);
+    packet[length - 1] = static_cast<uint8_t>(crc >> 8U);
+    TEST_ASSERT_TRUE(sendPacket(receiver, packet, length));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1, receiver.getErrorStatistics().crcErrorCount);
+    TEST_ASSERT_EQUAL(1, receiver.getErrorStatistics().truncatedFrameCount);
+}
+
+void test_receiver_exbus_telemetry()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverEXBUS::BAUD_RATE, ReceiverEXBUS::DATA_BITS, ReceiverEXBUS::STOP_BITS, ReceiverEXBUS::PARITY);
+    static ReceiverEXBUS receiver(serialPort);
+
+    packet_t request {};
+    const size_t length = makePacket(request, ReceiverEXBUS::HEADER_REQUEST, ReceiverEXBUS::HEADER2_REQUEST, 0x5A, ReceiverEXBUS::DATA_ID_TELEMETRY, nullptr, 0);
+    TEST_ASSERT_EQUAL(8, length);
+
+    // no telemetry data set, so no reply
+    TEST_ASSERT_TRUE(sendPacket(receiver, request, length));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(0, receiver.getResponseCount());
+
+    const std::array<uint8_t, 5> telemetry = { 0x9F, 0x15, 0xA4, 0x00, 0x11 };
+    TEST_ASSERT_TRUE(receiver.setTelemetryData(&telemetry[0], telemetry.size()));
+    TEST_ASSERT_TRUE(sendPacket(receiver, request, length));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1, receiver.getResponseCount());
+
+    const ReceiverEXBUS::response_t& response = receiver.getResponse();
+    TEST_ASSERT_EQUAL(13, response.length);
+    TEST_ASSERT_EQUAL(ReceiverEXBUS::HEADER_REPLY, response.data[0]);
+    TEST_ASSERT_EQUAL(ReceiverEXBUS::HEADER2_REQUEST, response.data[1]);
+    TEST_ASSERT_EQUAL(13, response.data[2]);
+    TEST_ASSERT_EQUAL(0x5A, response.data[3]); // packet ID echoed
+    TEST_ASSERT_EQUAL(ReceiverEXBUS::DATA_ID_TELEMETRY, response.data[4]);
+    TEST_ASSERT_EQUAL(5, response.data[5]);
+    TEST_ASSERT_EQUAL(0x9F, response.data[6]);
+    TEST_ASSERT_EQUAL(0x11, response.data[10]);
+    // CRC over whole reply, including CRC, is zero
+    TEST_ASSERT_EQUAL_HEX16(0, ReceiverEXBUS::calculateCRC(&response.data[0], response.length));
+
+    // new telemetry data set after the reply was sent does not change the sent reply
+    const std::array<uint8_t, 3> telemetry2 = { 0x01, 0x02, 0x03 };
+    TEST_ASSERT_TRUE(receiver.setTelemetryData(&telemetry2[0], telemetry2.size()));
+    TEST_ASSERT_TRUE(receiver.setTelemetryData(&telemetry2[0], telemetry2.size()));
+    TEST_ASSERT_EQUAL(13, response.length);
+    TEST_ASSERT_EQUAL(0x9F, response.data[6]);
+    TEST_ASSERT_EQUAL_HEX16(0, ReceiverEXBUS::calculateCRC(&response.data[0], response.length));
+
+    // and is sent in reply to the next request
+    TEST_ASSERT_TRUE(sendPacket(receiver, request, length));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(2, receiver.getResponseCount());
+    TEST_ASSERT_EQUAL(11, response.length);
+    TEST_ASSERT_EQUAL(0x5A, response.data[3]);
+    TEST_ASSERT_EQUAL(0x01, response.data[6]);
+    TEST_ASSERT_EQUAL_HEX16(0, ReceiverEXBUS::calculateCRC(&response.data[0], response.length));
+
+    // too large
+    std::array<uint8_t, ReceiverEXBUS::MAX_TELEMETRY_DATA_SIZE + 1> tooLarge {};
+    TEST_ASSERT_FALSE(receiver.setTelemetryData(&tooLarge[0], tooLarge.size()));
+
+    // request handled too late is not answered
+    TEST_ASSERT_TRUE(sendPacket(receiver, request, length));
+    std::this_thread::sleep_for(std::chrono::microseconds(ReceiverEXBUS::MAX_RESPONSE_DELAY_US + 1000));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(2, receiver.getResponseCount());
+    TEST_ASSERT_EQUAL(1, receiver.getLateRequestCount());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_exbus_crc);
+    RUN_TEST(test_receiver_exbus_channels);
+    RUN_TEST(test_receiver_exbus_telemetry);
+
+    UNITY_END();
+}
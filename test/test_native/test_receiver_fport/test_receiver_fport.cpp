@@ -0,0 +1,104 @@
+#include "ReceiverFPort.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+void test_receiver_fport_control_frame()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, 0, ReceiverFPort::DATA_BITS, ReceiverFPort::STOP_BITS, ReceiverFPort::PARITY);
+    static ReceiverFPort receiver(serialPort);
+
+    // channels 172, 992, 1811, 992, then 992 for the remaining channels, RSSI of 0x7E which is byte-stuffed
+    const std::array<uint8_t, 30> frame = {
+        0x7E, 0x19, 0x00, 0xAC, 0x00, 0xDF, 0xC4, 0xC1, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0xE0, 0x03,
+        0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x7D, 0x5E, 0x12, 0x7E
+    };
+
+    size_t completeIndex = 0;
+    for (size_t ii = 0; ii < frame.size(); ++ii) {
+        if (receiver.onDataReceivedFromISR(frame[ii])) {
+            completeIndex = ii;
+        }
+    }
+    // frame is complete on the CRC byte, without waiting for the closing marker
+    TEST_ASSERT_EQUAL(28, completeIndex);
+    TEST_ASSERT_FALSE(receiver.isPacketEmpty());
+
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(0x7E, receiver.getRSSI());
+    TEST_ASSERT_FALSE(receiver.isFailsafe());
+    TEST_ASSERT_EQUAL(987, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(2011, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::AUX12));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(16));
+
+    // corrupt the CRC
+    std::array<uint8_t, 30> badFrame = frame;
+    badFrame[28] = 0x13;
+    for (uint8_t data : badFrame) {
+        receiver.onDataReceivedFromISR(data);
+    }
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+}
+
+void test_receiver_fport_telemetry()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, 0, ReceiverFPort::DATA_BITS, ReceiverFPort::STOP_BITS, ReceiverFPort::PARITY);
+    static ReceiverFPort receiver(serialPort);
+
+    const std::array<uint8_t, 12> poll = { 0x7E, 0x08, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF6, 0x7E };
+
+    // nothing queued, so empty frame is sent
+    for (uint8_t data : poll) {
+        receiver.onDataReceivedFromISR(data);
+    }
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    const ReceiverFPort::response_t& response = receiver.getResponse();
+    TEST_ASSERT_EQUAL(10, response.length);
+    TEST_ASSERT_EQUAL(ReceiverFPort::RESPONSE_FRAME_LENGTH, response.data[0]);
+    TEST_ASSERT_EQUAL(ReceiverFPort::FRAME_TYPE_RESPONSE, response.data[1]);
+    TEST_ASSERT_EQUAL(ReceiverFPort::SPORT_FRAME_ID_EMPTY, response.data[2]);
+    TEST_ASSERT_EQUAL(ReceiverFPort::calculateCRC(&response.data[0], 9), response.data[9]);
+
+    // queued value is sent on next poll, value contains a byte that must be stuffed
+    TEST_ASSERT_TRUE(receiver.queueTelemetry(0x0210, 0x0000017D));
+    for (uint8_t data : poll) {
+        receiver.onDataReceivedFromISR(data);
+    }
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(11, response.length);
+    TEST_ASSERT_EQUAL(ReceiverFPort::SPORT_FRAME_ID_DATA, response.data[2]);
+    TEST_ASSERT_EQUAL(0x10, response.data[3]);
+    TEST_ASSERT_EQUAL(0x02, response.data[4]);
+    TEST_ASSERT_EQUAL(ReceiverFPort::ESCAPE_BYTE, response.data[5]);
+    TEST_ASSERT_EQUAL(0x7D ^ ReceiverFPort::ESCAPE_XOR, response.data[6]);
+    TEST_ASSERT_EQUAL(0x01, response.data[7]);
+
+    // queue is bounded
+    for (size_t ii = 0; ii < ReceiverFPort::TELEMETRY_QUEUE_LENGTH; ++ii) {
+        TEST_ASSERT_TRUE(receiver.queueTelemetry(0x0100, static_cast<uint32_t>(ii)));
+    }
+    TEST_ASSERT_FALSE(receiver.queueTelemetry(0x0100, 0));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_fport_control_frame);
+    RUN_TEST(test_receiver_fport_telemetry);
+
+    UNITY_END();
+}
@@ -0,0 +1,162 @@
+#include "CockpitBase.h"
+#include "ReceiverFrameQueue.h"
+#include "ReceiverTask.h"
+#include "ReceiverVirtual.h"
+
+#include <atomic>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class CockpitTest : public CockpitBase {
+public:
+    explicit CockpitTest(ReceiverBase& receiver) : CockpitBase(receiver) {}
+    virtual void updateControls(const controls_t& controls) override { _controls = controls; ++_updateCount; }
+    virtual void checkFailsafe(uint32_t tickCount) override { (void)tickCount; ++_failsafeCheckCount; }
+    const controls_t& getControls() const { return _controls; }
+    uint32_t getUpdateCount() const { return _updateCount; }
+    uint32_t getFailsafeCheckCount() const { return _failsafeCheckCount; }
+private:
+    controls_t _controls {};
+    uint32_t _updateCount {};
+    uint32_t _failsafeCheckCount {};
+};
+
+static receiver_frame_t makeFrame(uint32_t tickCount)
+{
+    receiver_frame_t frame {};
+    frame.controls.tickCount = tickCount;
+    frame.snapshot.sequence = tickCount;
+    return frame;
+}
+
+void test_receiver_frame_queue_drop_oldest()
+{
+    static ReceiverFrameQueue queue(ReceiverFrameQueue::OVERFLOW_DROP_OLDEST);
+    receiver_frame_t frame {};
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_FALSE(queue.pop(frame));
+
+    for (uint32_t ii = 0; ii < ReceiverFrameQueue::CAPACITY + 3; ++ii) {
+        TEST_ASSERT_TRUE(queue.push(makeFrame(ii)));
+    }
+    TEST_ASSERT_EQUAL(ReceiverFrameQueue::CAPACITY, queue.size());
+    TEST_ASSERT_EQUAL(ReceiverFrameQueue::CAPACITY, queue.getMaxSize());
+    TEST_ASSERT_EQUAL(3, queue.getOverflowCount());
+    TEST_ASSERT_EQUAL(ReceiverFrameQueue::CAPACITY + 3, queue.getPushCount());
+
+    // oldest three were dropped
+    for (uint32_t ii = 3; ii < ReceiverFrameQueue::CAPACITY + 3; ++ii) {
+        TEST_ASSERT_TRUE(queue.pop(frame));
+        TEST_ASSERT_EQUAL(ii, frame.controls.tickCount);
+    }
+    TEST_ASSERT_FALSE(queue.pop(frame));
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_receiver_frame_queue_keep_all()
+{
+    static ReceiverFrameQueue queue(ReceiverFrameQueue::OVERFLOW_KEEP_ALL);
+    for (uint32_t ii = 0; ii < ReceiverFrameQueue::CAPACITY; ++ii) {
+        TEST_ASSERT_TRUE(queue.push(makeFrame(ii)));
+    }
+    TEST_ASSERT_FALSE(queue.push(makeFrame(100)));
+    TEST_ASSERT_EQUAL(1, queue.getOverflowCount());
+
+    // newest was discarded
+    receiver_frame_t frame {};
+    TEST_ASSERT_TRUE(queue.pop(frame));
+    TEST_ASSERT_EQUAL(0, frame.controls.tickCount);
+    TEST_ASSERT_TRUE(queue.push(makeFrame(101)));
+    for (uint32_t ii = 1; ii < ReceiverFrameQueue::CAPACITY; ++ii) {
+        TEST_ASSERT_TRUE(queue.pop(frame));
+        TEST_ASSERT_EQUAL(ii, frame.controls.tickCount);
+    }
+    TEST_ASSERT_TRUE(queue.pop(frame));
+    TEST_ASSERT_EQUAL(101, frame.controls.tickCount);
+}
+
+void test_receiver_frame_queue_decoupled_receiver_task()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    static ReceiverFrameQueue queue;
+    ReceiverTask receiverTask(1000, receiver, cockpit);
+    receiverTask.setFrameQueue(&queue);
+
+    receiver.setAuxiliaryChannelPWM(0, 1234);
+    receiverTask.loop();
+    receiverTask.loop();
+    // cockpit is not called by the receiver task
+    TEST_ASSERT_EQUAL(0, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(2, queue.size());
+
+    TEST_ASSERT_EQUAL(2, queue.drain(cockpit, 0));
+    TEST_ASSERT_EQUAL(2, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(0, cockpit.getFailsafeCheckCount());
+    // nothing queued, so drain checks failsafe
+    TEST_ASSERT_EQUAL(0, queue.drain(cockpit, 0));
+    TEST_ASSERT_EQUAL(1, cockpit.getFailsafeCheckCount());
+
+    receiverTask.loop();
+    receiver_frame_t frame {};
+    TEST_ASSERT_TRUE(queue.pop(frame));
+    TEST_ASSERT_EQUAL(3, frame.snapshot.sequence);
+    TEST_ASSERT_EQUAL(1234, frame.snapshot.channels[ReceiverBase::AUX1]);
+}
+
+void test_receiver_frame_queue_concurrent()
+{
+    enum { PUSH_COUNT = 200000 };
+    static ReceiverFrameQueue queue(ReceiverFrameQueue::OVERFLOW_DROP_OLDEST);
+    std::atomic<bool> done {false};
+    uint32_t popCount = 0;
+    uint32_t errorCount = 0;
+
+    std::thread consumer([&]() {
+        receiver_frame_t frame {};
+        uint32_t previous = 0;
+        bool first = true;
+        while (!done || !queue.empty()) {
+            if (queue.pop(frame)) {
+                ++popCount;
+                // frames are in order, and never torn
+                if ((!first && frame.controls.tickCount <= previous) || frame.snapshot.sequence != frame.controls.tickCount) {
+                    ++errorCount;
+                }
+                first = false;
+                previous = frame.controls.tickCount;
+            }
+        }
+    });
+    for (uint32_t ii = 0; ii < PUSH_COUNT; ++ii) {
+        queue.push(makeFrame(ii));
+    }
+    done = true;
+    consumer.join();
+
+    TEST_ASSERT_EQUAL(0, errorCount);
+    // every frame is either popped or counted as an overflow
+    TEST_ASSERT_EQUAL(PUSH_COUNT, popCount + queue.getOverflowCount());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_frame_queue_drop_oldest);
+    RUN_TEST(test_receiver_frame_queue_keep_all);
+    RUN_TEST(test_receiver_frame_queue_decoupled_receiver_task);
+    RUN_TEST(test_receiver_frame_queue_concurrent);
+
+    UNITY_END();
+}
@@ -0,0 +1,116 @@
+#include "ReceiverCRC.h"
+#include "ReceiverGHST.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+typedef std::array<uint8_t, ReceiverGHST::RC_FRAME_LENGTH + 2> frame_t;
+
+// primary channels 12-bit values 2048 (roll), 0 (pitch), 4095 (throttle), 2048 (yaw), followed by 4 auxiliary bytes
+static frame_t makeFrame(uint8_t type, uint8_t aux0, uint8_t aux1, uint8_t aux2, uint8_t aux3)
+{
+    frame_t frame = {
+        ReceiverGHST::ADDRESS_FLIGHT_CONTROLLER, ReceiverGHST::RC_FRAME_LENGTH, type,
+        0x00, 0x08, 0x00, 0xFF, 0x0F, 0x80,
+        aux0, aux1, aux2, aux3,
+        0
+    };
+    frame[frame.size() - 1] = ReceiverGHST::calculateCRC(&frame[2], ReceiverGHST::RC_FRAME_LENGTH - 1);
+    return frame;
+}
+
+static bool sendFrame(ReceiverGHST& receiver, const frame_t& frame)
+{
+    bool complete = false;
+    for (uint8_t data : frame) {
+        complete = receiver.onDataReceivedFromISR(data);
+    }
+    return complete;
+}
+
+void test_receiver_ghst_crc()
+{
+    // CRC8 DVB-S2 check value
+    const std::array<uint8_t, 9> data = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX8(0xBC, ReceiverGHST::calculateCRC(&data[0], data.size()));
+    TEST_ASSERT_EQUAL_HEX8(0xBC, crc8_DVB_S2(0, &data[0], data.size()));
+}
+
+void test_receiver_ghst_channels()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverGHST::BAUD_RATE, ReceiverGHST::DATA_BITS, ReceiverGHST::STOP_BITS, ReceiverGHST::PARITY);
+    static ReceiverGHST receiver(serialPort);
+
+    TEST_ASSERT_TRUE(sendFrame(receiver, makeFrame(ReceiverGHST::FRAMETYPE_RC_CHANNELS_5_TO_8, 0, 128, 255, 64)));
+    TEST_ASSERT_FALSE(receiver.isPacketEmpty());
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(2011, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::AUX1));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::AUX2));
+    TEST_ASSERT_EQUAL(2008, receiver.getChannelPWM(ReceiverBase::AUX3));
+    TEST_ASSERT_EQUAL(1244, receiver.getChannelPWM(ReceiverBase::AUX4));
+
+    // second group is merged, first group is retained
+    TEST_ASSERT_TRUE(sendFrame(receiver, makeFrame(ReceiverGHST::FRAMETYPE_RC_CHANNELS_13_TO_16, 128, 128, 128, 255)));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::AUX2));
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::AUX5));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::AUX9));
+    TEST_ASSERT_EQUAL(2008, receiver.getChannelPWM(ReceiverBase::AUX12));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(ReceiverGHST::CHANNEL_COUNT));
+
+    // bad CRC
+    frame_t frame = makeFrame(ReceiverGHST::FRAMETYPE_RC_CHANNELS_9_TO_12, 255, 255, 255, 255);
+    frame[frame.size() - 1] ^= 0x01;
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::AUX6)); // not updated
+
+    // frames not addressed to the flight controller are ignored
+    frame = makeFrame(ReceiverGHST::FRAMETYPE_RC_CHANNELS_9_TO_12, 255, 255, 255, 255);
+    frame[0] = ReceiverGHST::ADDRESS_GOGGLES;
+    TEST_ASSERT_FALSE(sendFrame(receiver, frame));
+}
+
+void test_receiver_ghst_link_statistics()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverGHST::BAUD_RATE, ReceiverGHST::DATA_BITS, ReceiverGHST::STOP_BITS, ReceiverGHST::PARITY);
+    static ReceiverGHST receiver(serialPort);
+
+    TEST_ASSERT_FALSE(receiver.isLinkStatisticsReceived());
+    // LQ 97%, RSSI -85dBm, protocol 2, tx power 20dBm
+    TEST_ASSERT_TRUE(sendFrame(receiver, makeFrame(ReceiverGHST::FRAMETYPE_RC_CHANNELS_12_RSSI, 97, 85, 2, 20)));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isLinkStatisticsReceived());
+    TEST_ASSERT_EQUAL(97, receiver.getLinkQuality());
+    TEST_ASSERT_EQUAL(-85, receiver.getRSSI_dBm());
+    TEST_ASSERT_EQUAL(2, receiver.getRF_Protocol());
+    TEST_ASSERT_EQUAL(20, receiver.getTxPower_dBm());
+    TEST_ASSERT_EQUAL(2011, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    // link statistics are not channel values
+    TEST_ASSERT_EQUAL(988, receiver.getChannelPWM(ReceiverBase::AUX1));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_ghst_crc);
+    RUN_TEST(test_receiver_ghst_channels);
+    RUN_TEST(test_receiver_ghst_link_statistics);
+
+    UNITY_END();
+}
@@ -0,0 +1,169 @@
+#include "ReceiverCRC.h"
+#include "ReceiverMSP.h"
+
+#include <chrono>
+#include <thread>
+#include <unity.h>
+#include <vector>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+static std::vector<uint8_t> makeFrameV1(uint8_t command, const std::vector<uint16_t>& channels)
+{
+    std::vector<uint8_t> frame = { '$', 'M', '<', static_cast<uint8_t>(channels.size() * 2), command };
+    for (uint16_t channel : channels) {
+        frame.push_back(static_cast<uint8_t>(channel));
+        frame.push_back(static_cast<uint8_t>(channel >> 8U));
+    }
+    uint8_t checksum = 0;
+    for (size_t ii = 3; ii < frame.size(); ++ii) {
+        checksum ^= frame[ii];
+    }
+    frame.push_back(checksum);
+    return frame;
+}
+
+static std::vector<uint8_t> makeFrameV2(uint16_t command, const std::vector<uint16_t>& channels)
+{
+    const auto size = static_cast<uint16_t>(channels.size() * 2);
+    std::vector<uint8_t> frame = { '$', 'X', '<', 0, static_cast<uint8_t>(command), static_cast<uint8_t>(command >> 8U), static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8U) };
+    for (uint16_t channel : channels) {
+        frame.push_back(static_cast<uint8_t>(channel));
+        frame.push_back(static_cast<uint8_t>(channel >> 8U));
+    }
+    frame.push_back(crc8_DVB_S2(0, &frame[3], frame.size() - 3));
+    return frame;
+}
+
+static bool sendFrame(ReceiverMSP& receiver, const std::vector<uint8_t>& frame)
+{
+    bool complete = false;
+    for (uint8_t data : frame) {
+        complete = receiver.onDataReceivedFromISR(data);
+    }
+    return complete;
+}
+
+void test_receiver_msp_v1()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverMSP::BAUD_RATE, ReceiverMSP::DATA_BITS, ReceiverMSP::STOP_BITS, ReceiverMSP::PARITY);
+    static ReceiverMSP receiver(serialPort);
+
+    const std::vector<uint8_t> frame = makeFrameV1(ReceiverMSP::MSP_SET_RAW_RC, { 1100, 1200, 1000, 1900, 2000, 1500, 1000, 1700 });
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_FALSE(receiver.isPacketEmpty());
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+    TEST_ASSERT_EQUAL(8, receiver.getChannelCount());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1200, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1900, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(1700, receiver.getChannelPWM(ReceiverBase::AUX4));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(ReceiverMSP::CHANNEL_COUNT));
+
+    // acknowledgement
+    const ReceiverMSP::response_t& ack = receiver.getLastResponse();
+    TEST_ASSERT_EQUAL(6, ack.length);
+    TEST_ASSERT_EQUAL('$', ack.data[0]);
+    TEST_ASSERT_EQUAL('M', ack.data[1]);
+    TEST_ASSERT_EQUAL('>', ack.data[2]);
+    TEST_ASSERT_EQUAL(0, ack.data[3]);
+    TEST_ASSERT_EQUAL(ReceiverMSP::MSP_SET_RAW_RC, ack.data[4]);
+    TEST_ASSERT_EQUAL(ReceiverMSP::MSP_SET_RAW_RC, ack.data[5]);
+
+    // bad checksum
+    std::vector<uint8_t> badFrame = frame;
+    badFrame.back() ^= 0x01;
+    TEST_ASSERT_FALSE(sendFrame(receiver, badFrame));
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+
+    // unsupported command gets an error reply
+    TEST_ASSERT_TRUE(sendFrame(receiver, makeFrameV1(101, {})));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL('!', receiver.getLastResponse().data[2]);
+
+    // too few channels
+    TEST_ASSERT_TRUE(sendFrame(receiver, makeFrameV1(ReceiverMSP::MSP_SET_RAW_RC, { 1500, 1500 })));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(8, receiver.getChannelCount());
+
+    // payload too large is discarded, and the parser resynchronizes on the next frame
+    std::vector<uint16_t> tooManyChannels(ReceiverMSP::CHANNEL_COUNT + 1, 1500);
+    TEST_ASSERT_FALSE(sendFrame(receiver, makeFrameV1(ReceiverMSP::MSP_SET_RAW_RC, tooManyChannels)));
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+
+    // a frame that stops part way through is dropped when the timeout expires, and all its bytes are discarded
+    const uint32_t droppedPacketCount = receiver.getDroppedPacketCount();
+    const ReceiverBase::error_statistics_t errorStatistics = receiver.getErrorStatistics();
+    const std::vector<uint8_t> partialFrame(frame.begin(), frame.begin() + 10);
+    TEST_ASSERT_FALSE(sendFrame(receiver, partialFrame));
+    std::this_thread::sleep_for(std::chrono::microseconds(ReceiverMSP::TIME_NEEDED_PER_FRAME_US + 1000));
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(droppedPacketCount + 1, receiver.getDroppedPacketCount());
+    TEST_ASSERT_EQUAL(errorStatistics.truncatedFrameCount + 1, receiver.getErrorStatistics().truncatedFrameCount);
+    TEST_ASSERT_EQUAL(errorStatistics.discardedByteCount + 10, receiver.getErrorStatistics().discardedByteCount);
+
+    // an idle gap between frames is not an error
+    std::this_thread::sleep_for(std::chrono::microseconds(ReceiverMSP::TIME_NEEDED_PER_FRAME_US + 1000));
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_EQUAL(droppedPacketCount + 1, receiver.getDroppedPacketCount());
+}
+
+void test_receiver_msp_v2()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverMSP::BAUD_RATE, ReceiverMSP::DATA_BITS, ReceiverMSP::STOP_BITS, ReceiverMSP::PARITY);
+    static ReceiverMSP receiver(serialPort);
+
+    // all channels
+    std::vector<uint16_t> channels(ReceiverMSP::CHANNEL_COUNT);
+    for (size_t ii = 0; ii < channels.size(); ++ii) {
+        channels[ii] = static_cast<uint16_t>(1000 + 50*ii);
+    }
+    TEST_ASSERT_TRUE(sendFrame(receiver, makeFrameV2(ReceiverMSP::MSP_SET_RAW_RC, channels)));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(ReceiverMSP::CHANNEL_COUNT, receiver.getChannelCount());
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(0));
+    TEST_ASSERT_EQUAL(1850, receiver.getChannelPWM(ReceiverMSP::CHANNEL_COUNT - 1));
+
+    float throttle {};
+    float roll {};
+    float pitch {};
+    float yaw {};
+    receiver.getStickValues(throttle, roll, pitch, yaw);
+    TEST_ASSERT_EQUAL_FLOAT(0.1F, throttle);
+    TEST_ASSERT_EQUAL_FLOAT(-0.5F, roll);
+
+    const ReceiverMSP::response_t& ack = receiver.getLastResponse();
+    TEST_ASSERT_EQUAL(9, ack.length);
+    TEST_ASSERT_EQUAL('X', ack.data[1]);
+    TEST_ASSERT_EQUAL('>', ack.data[2]);
+    TEST_ASSERT_EQUAL(ReceiverMSP::MSP_SET_RAW_RC, ack.data[4]);
+    TEST_ASSERT_EQUAL(0, ack.data[5]);
+    TEST_ASSERT_EQUAL(crc8_DVB_S2(0, &ack.data[3], 5), ack.data[8]);
+
+    // bad CRC
+    std::vector<uint8_t> badFrame = makeFrameV2(ReceiverMSP::MSP_SET_RAW_RC, { 1500, 1500, 1500, 1500 });
+    badFrame[10] ^= 0x01;
+    TEST_ASSERT_FALSE(sendFrame(receiver, badFrame));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_msp_v1);
+    RUN_TEST(test_receiver_msp_v2);
+
+    UNITY_END();
+}
@@ -0,0 +1,128 @@
+#include "ReceiverPPM.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+static timeUs32_t edgeTimeUs = 100000;
+
+// sends the channel pulses followed by a sync gap, returns true if the frame was completed
+template <size_t N>
+static bool sendFrame(ReceiverPPM& receiver, const std::array<uint16_t, N>& pulses)
+{
+    for (uint16_t pulse : pulses) {
+        edgeTimeUs += pulse;
+        receiver.onPulseEdgeFromISR(edgeTimeUs);
+    }
+    edgeTimeUs += 6000; // sync gap
+    return receiver.onPulseEdgeFromISR(edgeTimeUs);
+}
+
+void test_receiver_ppm_median()
+{
+    TEST_ASSERT_EQUAL(2, ReceiverPPM::median(1, 2, 3));
+    TEST_ASSERT_EQUAL(2, ReceiverPPM::median(3, 2, 1));
+    TEST_ASSERT_EQUAL(2, ReceiverPPM::median(2, 3, 1));
+    TEST_ASSERT_EQUAL(2, ReceiverPPM::median(1, 3, 2));
+    TEST_ASSERT_EQUAL(2, ReceiverPPM::median(3, 1, 2));
+    TEST_ASSERT_EQUAL(2, ReceiverPPM::median(2, 2, 3));
+    TEST_ASSERT_EQUAL(5, ReceiverPPM::median(5, 5, 5));
+}
+
+void test_receiver_ppm()
+{
+    static ReceiverPPM receiver;
+
+    const std::array<uint16_t, 8> frame = { 1100, 1200, 1000, 1900, 2000, 1500, 1000, 1700 };
+
+    // edges before the first sync gap are ignored, first frame after sync is not yet stable
+    receiver.onPulseEdgeFromISR(edgeTimeUs);
+    edgeTimeUs += 1500;
+    receiver.onPulseEdgeFromISR(edgeTimeUs);
+    edgeTimeUs += 6000;
+    TEST_ASSERT_FALSE(receiver.onPulseEdgeFromISR(edgeTimeUs));
+    TEST_ASSERT_FALSE(sendFrame(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_FALSE(receiver.isPacketEmpty());
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+    TEST_ASSERT_FALSE(receiver.update(0));
+    TEST_ASSERT_EQUAL(8, receiver.getChannelCount());
+    TEST_ASSERT_EQUAL(4, receiver.getAuxiliaryChannelCount());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1200, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1900, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(1700, receiver.getChannelPWM(ReceiverBase::AUX4));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(8));
+
+    // single frame glitch is removed by the median filter
+    std::array<uint16_t, 8> glitch = frame;
+    glitch[ReceiverBase::ROLL] = 1800;
+    TEST_ASSERT_TRUE(sendFrame(receiver, glitch));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+
+    // sustained change comes through on the second frame
+    std::array<uint16_t, 8> moved = frame;
+    moved[ReceiverBase::ROLL] = 1300;
+    TEST_ASSERT_TRUE(sendFrame(receiver, moved));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(1300, receiver.getChannelPWM(ReceiverBase::ROLL));
+
+    // out of range pulse rejects the frame, the next frame with the same channel count is accepted
+    const uint32_t rejectedFrameCount = receiver.getRejectedFrameCount();
+    std::array<uint16_t, 8> outlier = frame;
+    outlier[3] = 2500;
+    TEST_ASSERT_FALSE(sendFrame(receiver, outlier));
+    TEST_ASSERT_EQUAL(rejectedFrameCount + 1, receiver.getRejectedFrameCount());
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+
+    // too few channels
+    const std::array<uint16_t, 6> shortFrame = { 1500, 1500, 1500, 1500, 1500, 1500 };
+    TEST_ASSERT_FALSE(sendFrame(receiver, shortFrame));
+    TEST_ASSERT_EQUAL(rejectedFrameCount + 2, receiver.getRejectedFrameCount());
+
+    // a short frame between good frames restarts the stability check
+    TEST_ASSERT_FALSE(sendFrame(receiver, frame));
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_FALSE(sendFrame(receiver, shortFrame));
+
+    // 12 channel frame, filter restarts when the channel count changes
+    const std::array<uint16_t, 12> longFrame = { 1500, 1500, 1000, 1500, 1100, 1200, 1300, 1400, 1500, 1600, 1700, 1800 };
+    TEST_ASSERT_FALSE(sendFrame(receiver, longFrame));
+    TEST_ASSERT_TRUE(sendFrame(receiver, longFrame));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(12, receiver.getChannelCount());
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1800, receiver.getChannelPWM(11));
+
+    float throttle {};
+    float roll {};
+    float pitch {};
+    float yaw {};
+    receiver.getStickValues(throttle, roll, pitch, yaw);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, throttle);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, roll);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_ppm_median);
+    RUN_TEST(test_receiver_ppm);
+
+    UNITY_END();
+}
@@ -0,0 +1,113 @@
+#include "CockpitBase.h"
+#include "ReceiverProbe.h"
+#include "ReceiverTask.h"
+#include "ReceiverTelemetry.h"
+#include "ReceiverTelemetryData.h"
+#include "ReceiverVirtual.h"
+
+#include <chrono>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+    ReceiverProbe::init();
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class CockpitTest : public CockpitBase {
+public:
+    explicit CockpitTest(ReceiverBase& receiver) : CockpitBase(receiver) {}
+    virtual void updateControls(const controls_t& controls) override { (void)controls; }
+    virtual void checkFailsafe(uint32_t tickCount) override { (void)tickCount; }
+};
+
+void test_receiver_probe_scope()
+{
+    TEST_ASSERT_EQUAL(0, ReceiverProbe::getStats(ReceiverProbe::UNPACK_PACKET).count);
+    TEST_ASSERT_EQUAL(0, ReceiverProbe::getMeanCycles(ReceiverProbe::UNPACK_PACKET));
+
+    {
+        RECEIVER_PROBE(UNPACK_PACKET);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    const ReceiverProbe::stats_t& stats = ReceiverProbe::getStats(ReceiverProbe::UNPACK_PACKET);
+    TEST_ASSERT_EQUAL(1, stats.count);
+    TEST_ASSERT_GREATER_THAN(0, stats.maxCycles);
+    TEST_ASSERT_EQUAL(stats.minCycles, stats.maxCycles);
+    TEST_ASSERT_EQUAL(stats.maxCycles, ReceiverProbe::getMeanCycles(ReceiverProbe::UNPACK_PACKET));
+
+    // an empty scope is shorter than one containing a sleep, so becomes the minimum
+    {
+        RECEIVER_PROBE(UNPACK_PACKET);
+    }
+    TEST_ASSERT_EQUAL(2, stats.count);
+    TEST_ASSERT_LESS_THAN(stats.maxCycles, stats.minCycles);
+    TEST_ASSERT_EQUAL(static_cast<uint64_t>(stats.minCycles) + stats.maxCycles, stats.totalCycles);
+
+    // other probes are unaffected
+    TEST_ASSERT_EQUAL(0, ReceiverProbe::getStats(ReceiverProbe::UPDATE).count);
+
+    ReceiverProbe::reset();
+    TEST_ASSERT_EQUAL(0, stats.count);
+    TEST_ASSERT_EQUAL(0, stats.totalCycles);
+}
+
+void test_receiver_probe_task_loop()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    ReceiverTask receiverTask(1000, receiver, cockpit);
+
+    for (int ii = 0; ii < 10; ++ii) {
+        receiverTask.loop();
+    }
+    TEST_ASSERT_EQUAL(10, ReceiverProbe::getStats(ReceiverProbe::TASK_LOOP).count);
+    TEST_ASSERT_EQUAL(10, ReceiverProbe::getStats(ReceiverProbe::UPDATE).count);
+    // update() is part of loop(), so cannot take longer
+    TEST_ASSERT_LESS_OR_EQUAL(ReceiverProbe::getStats(ReceiverProbe::TASK_LOOP).totalCycles, ReceiverProbe::getStats(ReceiverProbe::UPDATE).totalCycles);
+}
+
+void test_receiver_probe_telemetry()
+{
+    {
+        RECEIVER_PROBE(ON_DATA_RECEIVED);
+    }
+    {
+        RECEIVER_PROBE(TASK_LOOP);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    std::array<uint8_t, 256> buf {};
+    const size_t len = packTelemetryData_ReceiverProbes(&buf[0], 0x1234, 7);
+    TEST_ASSERT_EQUAL(sizeof(TD_RECEIVER_PROBES), len);
+    const auto* td = reinterpret_cast<const TD_RECEIVER_PROBES*>(&buf[0]); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    TEST_ASSERT_EQUAL(0x1234, td->id);
+    TEST_ASSERT_EQUAL(TD_RECEIVER::TYPE, td->type);
+    TEST_ASSERT_EQUAL(TD_RECEIVER_PROBES::SUB_TYPE, td->subType);
+    TEST_ASSERT_EQUAL(7, td->sequenceNumber);
+
+    TEST_ASSERT_EQUAL(1, td->probes[ReceiverProbe::ON_DATA_RECEIVED].count);
+    // unused probes report zero, rather than the UINT32_MAX used internally for the minimum
+    TEST_ASSERT_EQUAL(0, td->probes[ReceiverProbe::UNPACK_PACKET].count);
+    TEST_ASSERT_EQUAL(0, td->probes[ReceiverProbe::UNPACK_PACKET].minCycles);
+    TEST_ASSERT_EQUAL(1, td->probes[ReceiverProbe::TASK_LOOP].count);
+    TEST_ASSERT_GREATER_THAN(0, td->probes[ReceiverProbe::TASK_LOOP].meanCycles);
+    TEST_ASSERT_EQUAL(td->probes[ReceiverProbe::TASK_LOOP].minCycles, td->probes[ReceiverProbe::TASK_LOOP].maxCycles);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_probe_scope);
+    RUN_TEST(test_receiver_probe_task_loop);
+    RUN_TEST(test_receiver_probe_telemetry);
+
+    UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include "ReceiverSharedMemory.h"
+#include "ReceiverVirtual.h"
+
+#include <unity.h>
+
+#if defined(__linux__)
+#include <atomic>
+#include <thread>
+#endif
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+#if defined(__linux__)
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+void test_receiver_shared_memory()
+{
+    static const char* name = "/test_receiver_shared_memory";
+    ReceiverSharedMemoryReader earlyReader(name);
+    // region does not exist yet
+    TEST_ASSERT_FALSE(earlyReader.init());
+    ReceiverSharedMemoryExporter exporter(name);
+    TEST_ASSERT_TRUE(exporter.init());
+
+    ReceiverSharedMemoryReader reader(name);
+    TEST_ASSERT_TRUE(reader.init());
+    receiver_snapshot_t snapshot {};
+    // nothing published yet
+    TEST_ASSERT_FALSE(reader.read(snapshot));
+    TEST_ASSERT_EQUAL(0, reader.getSequence());
+
+    ReceiverVirtual receiver;
+    receiver.setControls({ .throttle = 0.5F, .roll = -0.25F, .pitch = 0.25F, .yaw = 0.0F });
+    receiver.setSwitch(1, 1);
+    receiver.setAuxiliaryChannelPWM(0, 1234);
+    receiver.setAuxiliaryChannelPWM(13, 1900);
+    receiver.update(0);
+    exporter.publish(receiver);
+
+    TEST_ASSERT_EQUAL(1, reader.getSequence());
+    TEST_ASSERT_TRUE(reader.read(snapshot));
+    TEST_ASSERT_EQUAL(1, snapshot.sequence);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, snapshot.controls.throttle);
+    TEST_ASSERT_EQUAL_FLOAT(-0.25F, snapshot.controls.roll);
+    TEST_ASSERT_EQUAL(receiver.getSwitches(), snapshot.switches);
+    TEST_ASSERT_EQUAL(18, snapshot.channelCount);
+    TEST_ASSERT_EQUAL(1234, snapshot.channels[ReceiverBase::AUX1]);
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_HIGH, snapshot.channels[ReceiverBase::AUX2]);
+    TEST_ASSERT_EQUAL(1900, snapshot.channels[17]);
+    TEST_ASSERT_EQUAL(1, snapshot.packetCount);
+
+    // a second reader in the same process sees the same data
+    ReceiverSharedMemoryReader reader2(name);
+    TEST_ASSERT_TRUE(reader2.init());
+    receiver_snapshot_t snapshot2 {};
+    TEST_ASSERT_TRUE(reader2.read(snapshot2));
+    TEST_ASSERT_EQUAL(snapshot.sequence, snapshot2.sequence);
+    TEST_ASSERT_EQUAL(1234, snapshot2.channels[ReceiverBase::AUX1]);
+
+    // reader created before the region existed can be initialized later
+    TEST_ASSERT_TRUE(earlyReader.init());
+    TEST_ASSERT_EQUAL(1, earlyReader.getSequence());
+}
+
+void test_receiver_shared_memory_concurrent()
+{
+    static const char* name = "/test_receiver_shared_memory_concurrent";
+    ReceiverSharedMemoryExporter exporter(name);
+    TEST_ASSERT_TRUE(exporter.init());
+    ReceiverSharedMemoryReader reader(name);
+    TEST_ASSERT_TRUE(reader.init());
+
+    enum { PUBLISH_COUNT = 200000 };
+    std::atomic<bool> done {false};
+    std::atomic<uint32_t> readCount {0};
+    std::thread writer([&exporter, &done, &readCount]() {
+        receiver_snapshot_t snapshot {};
+        for (uint32_t ii = 1; ii <= PUBLISH_COUNT; ++ii) {
+            // every channel has the same value, so a torn read is detectable
+            snapshot.channels.fill(static_cast<uint16_t>(ii));
+            snapshot.packetCount = static_cast<int32_t>(ii);
+            exporter.publish(snapshot);
+            if (ii == 1) {
+                // wait for the reader to read the first snapshot, so that the remaining writes overlap reads
+                while (readCount == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        done = true;
+    });
+
+    uint32_t tornCount = 0;
+    uint32_t previousSequence = 0;
+    uint32_t outOfOrderCount = 0;
+    receiver_snapshot_t snapshot {};
+    while (!done) {
+        if (reader.read(snapshot)) {
+            ++readCount;
+            for (uint16_t channel : snapshot.channels) {
+                if (channel != snapshot.channels[0]) {
+                    ++tornCount;
+                    break;
+                }
+            }
+            if (snapshot.channels[0] != static_cast<uint16_t>(snapshot.packetCount)) {
+                ++tornCount;
+            }
+            if (snapshot.sequence < previousSequence) {
+                ++outOfOrderCount;
+            }
+            previousSequence = snapshot.sequence;
+        }
+    }
+    writer.join();
+
+    TEST_ASSERT_EQUAL(0, tornCount);
+    TEST_ASSERT_EQUAL(0, outOfOrderCount);
+    TEST_ASSERT_GREATER_THAN(0, readCount.load());
+    TEST_ASSERT_TRUE(reader.read(snapshot));
+    TEST_ASSERT_EQUAL(PUBLISH_COUNT, snapshot.sequence);
+    TEST_ASSERT_EQUAL(PUBLISH_COUNT, exporter.getPublishCount());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+#endif // __linux__
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+#if defined(__linux__)
+    RUN_TEST(test_receiver_shared_memory);
+    RUN_TEST(test_receiver_shared_memory_concurrent);
+#endif
+
+    UNITY_END();
+}
@@ -0,0 +1,169 @@
+#include "ReceiverSRXL2.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+template <size_t N>
+static void setCRC(std::array<uint8_t, N>& packet)
+{
+    const uint16_t crc = ReceiverSRXL2::calculateCRC(&packet[0], N - 2);
+    packet[N - 2] = static_cast<uint8_t>(crc >> 8U);
+    packet[N - 1] = static_cast<uint8_t>(crc);
+}
+
+template <size_t N>
+static bool sendPacket(ReceiverSRXL2& receiver, const std::array<uint8_t, N>& packet)
+{
+    bool complete = false;
+    for (uint8_t data : packet) {
+        complete = receiver.onDataReceivedFromISR(data);
+    }
+    return complete;
+}
+
+static bool txPacketCRC_OK(const ReceiverSRXL2& receiver)
+{
+    const auto& tx = receiver.getTxPacket();
+    const size_t length = tx[2];
+    const uint16_t crc = ReceiverSRXL2::calculateCRC(&tx[0], length - 2);
+    return tx[length - 2] == static_cast<uint8_t>(crc >> 8U) && tx[length - 1] == static_cast<uint8_t>(crc);
+}
+
+void test_receiver_srxl2_crc()
+{
+    // CRC16-CCITT (XMODEM) check value
+    const std::array<uint8_t, 9> data = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x31C3, ReceiverSRXL2::calculateCRC(&data[0], data.size()));
+}
+
+void test_receiver_srxl2()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverSRXL2::BAUD_RATE, ReceiverSRXL2::DATA_BITS, ReceiverSRXL2::STOP_BITS, ReceiverSRXL2::PARITY);
+    static ReceiverSRXL2 receiver(serialPort);
+    serialPort.init();
+    TEST_ASSERT_TRUE(serialPort.isReceiving());
+    receiver.setUniqueId(0x12345678);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::STATE_WAITING_FOR_HANDSHAKE, receiver.getState());
+
+    // handshake from receiver to flight controller
+    std::array<uint8_t, ReceiverSRXL2::HANDSHAKE_PACKET_LENGTH> handshake = {
+        ReceiverSRXL2::SRXL2_SYNC_BYTE, ReceiverSRXL2::PACKET_TYPE_HANDSHAKE, ReceiverSRXL2::HANDSHAKE_PACKET_LENGTH,
+        ReceiverSRXL2::DEVICE_ID_RECEIVER, ReceiverSRXL2::DEVICE_ID_FLIGHT_CONTROLLER, 10, ReceiverSRXL2::BAUD_SUPPORTED_400000, 0,
+        0xAA, 0xBB, 0xCC, 0xDD, 0, 0
+    };
+    setCRC(handshake);
+    TEST_ASSERT_TRUE(sendPacket(receiver, handshake));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::STATE_WAITING_FOR_BROADCAST, receiver.getState());
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::DEVICE_ID_RECEIVER, receiver.getMasterDeviceId());
+
+    // handshake reply
+    const auto& tx = receiver.getTxPacket();
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::SRXL2_SYNC_BYTE, tx[0]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::PACKET_TYPE_HANDSHAKE, tx[1]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::HANDSHAKE_PACKET_LENGTH, tx[2]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::DEVICE_ID_FLIGHT_CONTROLLER, tx[3]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::DEVICE_ID_RECEIVER, tx[4]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::BAUD_SUPPORTED_400000, tx[6]);
+    TEST_ASSERT_EQUAL(0x78, tx[8]);
+    TEST_ASSERT_EQUAL(0x12, tx[11]);
+    TEST_ASSERT_TRUE(txPacketCRC_OK(receiver));
+
+    // broadcast handshake selects 400000 baud
+    handshake[4] = ReceiverSRXL2::DEVICE_ID_BROADCAST;
+    setCRC(handshake);
+    TEST_ASSERT_TRUE(sendPacket(receiver, handshake));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::STATE_RUNNING, receiver.getState());
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::BAUD_RATE_FAST, serialPort.getBaudrate());
+    // changing the baudrate must not stop reception
+    TEST_ASSERT_TRUE(serialPort.isReceiving());
+
+    // control packet with 4 channels, asking flight controller for telemetry
+    std::array<uint8_t, 22> control = {
+        ReceiverSRXL2::SRXL2_SYNC_BYTE, ReceiverSRXL2::PACKET_TYPE_CONTROL, 22,
+        ReceiverSRXL2::CONTROL_COMMAND_CHANNEL, ReceiverSRXL2::DEVICE_ID_FLIGHT_CONTROLLER, static_cast<uint8_t>(-50), 3, 0,
+        0x0F, 0x00, 0x00, 0x00,
+        0x00, 0x80, 0x00, 0x00, 0xE0, 0xFF, 0x00, 0x80,
+        0, 0
+    };
+    setCRC(control);
+    TEST_ASSERT_TRUE(sendPacket(receiver, control));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty()); // packet is not handled twice
+    TEST_ASSERT_EQUAL(-50, receiver.getRSSI());
+    TEST_ASSERT_EQUAL(3, receiver.getFrameLosses());
+    TEST_ASSERT_FALSE(receiver.isFailsafe());
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(0));
+    TEST_ASSERT_EQUAL(903, receiver.getChannelPWM(1));
+    TEST_ASSERT_EQUAL(2096, receiver.getChannelPWM(2));
+    TEST_ASSERT_EQUAL(1500, receiver.getChannelPWM(3));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(ReceiverSRXL2::CHANNEL_COUNT));
+
+    // nothing queued, so NO_DATA telemetry sent
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::PACKET_TYPE_TELEMETRY, tx[1]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::TELEMETRY_PACKET_LENGTH, tx[2]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::DEVICE_ID_RECEIVER, tx[3]);
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::TELEMETRY_SENSOR_NO_DATA, tx[4]);
+    TEST_ASSERT_TRUE(txPacketCRC_OK(receiver));
+
+    // queued telemetry is sent in the next reply slot
+    ReceiverSRXL2::telemetry_payload_t payload {};
+    payload[0] = 0x7E; // flight pack capacity sensor
+    payload[1] = 0x55;
+    TEST_ASSERT_TRUE(receiver.queueTelemetry(payload));
+    sendPacket(receiver, control);
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(0x7E, tx[4]);
+    TEST_ASSERT_EQUAL(0x55, tx[5]);
+    TEST_ASSERT_TRUE(txPacketCRC_OK(receiver));
+
+    // failsafe
+    control[3] = ReceiverSRXL2::CONTROL_COMMAND_FAILSAFE;
+    setCRC(control);
+    sendPacket(receiver, control);
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isFailsafe());
+
+    // bad CRC is rejected
+    control[3] = ReceiverSRXL2::CONTROL_COMMAND_CHANNEL;
+    sendPacket(receiver, control);
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isFailsafe());
+
+    // invalid length byte causes resync
+    TEST_ASSERT_FALSE(receiver.onDataReceivedFromISR(ReceiverSRXL2::SRXL2_SYNC_BYTE));
+    TEST_ASSERT_FALSE(receiver.onDataReceivedFromISR(ReceiverSRXL2::PACKET_TYPE_CONTROL));
+    TEST_ASSERT_FALSE(receiver.onDataReceivedFromISR(ReceiverSRXL2::MAX_PACKET_LENGTH + 1));
+    control[3] = ReceiverSRXL2::CONTROL_COMMAND_CHANNEL;
+    setCRC(control);
+    TEST_ASSERT_TRUE(sendPacket(receiver, control));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_FALSE(receiver.isFailsafe());
+
+    // loss of connection reverts to 115200 baud, and reception continues at that baudrate
+    TEST_ASSERT_EQUAL(0, receiver.WAIT_FOR_DATA_RECEIVED(ReceiverSRXL2::CONNECTION_TIMEOUT_US / 1000 + 10));
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::STATE_WAITING_FOR_HANDSHAKE, receiver.getState());
+    TEST_ASSERT_EQUAL(ReceiverSRXL2::BAUD_RATE, serialPort.getBaudrate());
+    TEST_ASSERT_TRUE(serialPort.isReceiving());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_srxl2_crc);
+    RUN_TEST(test_receiver_srxl2);
+
+    UNITY_END();
+}
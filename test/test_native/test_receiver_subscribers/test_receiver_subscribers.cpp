@@ -0,0 +1,188 @@
+#include "CockpitBase.h"
+#include "ReceiverSubscribers.h"
+#include "ReceiverTask.h"
+#include "ReceiverVirtual.h"
+
+#include <atomic>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class WatcherTest : public ReceiverWatcher {
+public:
+    virtual void newReceiverPacketAvailable() override { ++_count; }
+    uint32_t getCount() const { return _count; }
+private:
+    uint32_t _count {};
+};
+
+class CockpitTest : public CockpitBase {
+public:
+    explicit CockpitTest(ReceiverBase& receiver) : CockpitBase(receiver) {}
+    virtual void updateControls(const controls_t& controls) override { (void)controls; }
+    virtual void checkFailsafe(uint32_t tickCount) override { (void)tickCount; }
+};
+
+void test_receiver_subscribers()
+{
+    static ReceiverSubscribers subscribers;
+    TEST_ASSERT_EQUAL(0, subscribers.getSubscriberCount());
+
+    WatcherTest watcher;
+    const int32_t osd = subscribers.subscribe(&watcher);
+    const int32_t blackbox = subscribers.subscribe();
+    TEST_ASSERT_EQUAL(0, osd);
+    TEST_ASSERT_EQUAL(1, blackbox);
+    TEST_ASSERT_EQUAL(2, subscribers.getSubscriberCount());
+
+    receiver_snapshot_t snapshot {};
+    TEST_ASSERT_FALSE(subscribers.read(osd, snapshot));
+
+    ReceiverVirtual receiver;
+    receiver.setAuxiliaryChannelPWM(0, 1234);
+    receiver.update(0);
+    subscribers.publish(receiver);
+    TEST_ASSERT_EQUAL(1, subscribers.getPublishCount());
+    TEST_ASSERT_EQUAL(1, watcher.getCount());
+
+    // each subscriber gets its own copy
+    TEST_ASSERT_TRUE(subscribers.read(osd, snapshot));
+    TEST_ASSERT_EQUAL(1, snapshot.sequence);
+    TEST_ASSERT_EQUAL(1234, snapshot.channels[ReceiverBase::AUX1]);
+    TEST_ASSERT_FALSE(subscribers.read(osd, snapshot));
+    receiver_snapshot_t snapshot2 {};
+    TEST_ASSERT_TRUE(subscribers.read(blackbox, snapshot2));
+    TEST_ASSERT_EQUAL(1, snapshot2.sequence);
+
+    // blackbox does not read the next two snapshots before they are replaced
+    for (uint16_t ii = 0; ii < 3; ++ii) {
+        receiver.setAuxiliaryChannelPWM(0, static_cast<uint16_t>(1300 + ii));
+        receiver.update(0);
+        subscribers.publish(receiver);
+        TEST_ASSERT_TRUE(subscribers.read(osd, snapshot));
+    }
+    TEST_ASSERT_EQUAL(4, watcher.getCount());
+    TEST_ASSERT_EQUAL(0, subscribers.getMissedCount(osd));
+    TEST_ASSERT_EQUAL(2, subscribers.getMissedCount(blackbox));
+    TEST_ASSERT_TRUE(subscribers.read(blackbox, snapshot2));
+    TEST_ASSERT_EQUAL(4, snapshot2.sequence);
+    TEST_ASSERT_EQUAL(1302, snapshot2.channels[ReceiverBase::AUX1]);
+
+    // registry is full
+    const int32_t logger = subscribers.subscribe();
+    const int32_t telemetry = subscribers.subscribe();
+    TEST_ASSERT_EQUAL(ReceiverSubscribers::MAX_SUBSCRIBER_COUNT, subscribers.getSubscriberCount());
+    TEST_ASSERT_EQUAL(ReceiverSubscribers::NO_SUBSCRIBER, subscribers.subscribe());
+
+    // a freed slot is reused, and the new subscriber does not see the previous subscriber's snapshot
+    subscribers.unsubscribe(osd);
+    TEST_ASSERT_EQUAL(ReceiverSubscribers::MAX_SUBSCRIBER_COUNT - 1, subscribers.getSubscriberCount());
+    subscribers.publish(receiver);
+    TEST_ASSERT_EQUAL(4, watcher.getCount());
+    const int32_t osd2 = subscribers.subscribe();
+    TEST_ASSERT_EQUAL(osd, osd2);
+    TEST_ASSERT_FALSE(subscribers.read(osd2, snapshot));
+    TEST_ASSERT_EQUAL(0, subscribers.getMissedCount(osd2));
+    subscribers.publish(receiver);
+    TEST_ASSERT_TRUE(subscribers.read(osd2, snapshot));
+    TEST_ASSERT_EQUAL(6, snapshot.sequence);
+    TEST_ASSERT_EQUAL(1, subscribers.getMissedCount(logger));
+    TEST_ASSERT_EQUAL(1, subscribers.getMissedCount(telemetry));
+
+    TEST_ASSERT_FALSE(subscribers.read(ReceiverSubscribers::NO_SUBSCRIBER, snapshot));
+    TEST_ASSERT_FALSE(subscribers.read(ReceiverSubscribers::MAX_SUBSCRIBER_COUNT, snapshot));
+}
+
+void test_receiver_subscribers_receiver_task()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    ReceiverSubscribers subscribers;
+    receiver.setReceiverSubscribers(&subscribers);
+    const int32_t handle = subscribers.subscribe();
+    ReceiverTask receiverTask(1000, receiver, cockpit);
+
+    receiverTask.loop();
+    receiverTask.loop();
+    TEST_ASSERT_EQUAL(2, subscribers.getPublishCount());
+    receiver_snapshot_t snapshot {};
+    TEST_ASSERT_TRUE(subscribers.read(handle, snapshot));
+    TEST_ASSERT_EQUAL(2, snapshot.sequence);
+    TEST_ASSERT_EQUAL(1, subscribers.getMissedCount(handle));
+}
+
+void test_receiver_subscribers_concurrent()
+{
+    static ReceiverSubscribers subscribers;
+    enum { PUBLISH_COUNT = 100000, READER_COUNT = 2 };
+    std::atomic<bool> done {false};
+    std::atomic<int> startedCount {0};
+    std::array<uint32_t, READER_COUNT> readCounts {};
+    std::array<uint32_t, READER_COUNT> tornCounts {};
+    std::array<int32_t, READER_COUNT> handles {};
+    for (size_t ii = 0; ii < READER_COUNT; ++ii) {
+        handles[ii] = subscribers.subscribe();
+    }
+
+    std::array<std::thread, READER_COUNT> readers;
+    for (size_t ii = 0; ii < READER_COUNT; ++ii) {
+        readers[ii] = std::thread([&, ii]() {
+            receiver_snapshot_t snapshot {};
+            uint32_t previousSequence = 0;
+            ++startedCount;
+            while (!done) {
+                if (subscribers.read(handles[ii], snapshot)) {
+                    ++readCounts[ii];
+                    // every channel is written with the same value, so a torn read would show different values
+                    for (size_t jj = 1; jj < receiver_snapshot_t::CHANNEL_COUNT; ++jj) {
+                        if (snapshot.channels[jj] != snapshot.channels[0]) {
+                            ++tornCounts[ii];
+                            break;
+                        }
+                    }
+                    if (snapshot.sequence <= previousSequence) {
+                        ++tornCounts[ii];
+                    }
+                    previousSequence = snapshot.sequence;
+                }
+            }
+        });
+    }
+    while (startedCount < READER_COUNT) {}
+
+    receiver_snapshot_t snapshot {};
+    for (uint32_t ii = 0; ii < PUBLISH_COUNT; ++ii) {
+        snapshot.channels.fill(static_cast<uint16_t>(ii));
+        subscribers.publish(snapshot);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (size_t ii = 0; ii < READER_COUNT; ++ii) {
+        TEST_ASSERT_EQUAL(0, tornCounts[ii]);
+        // every snapshot was either read or counted as missed, allowing for the last one
+        TEST_ASSERT_LESS_OR_EQUAL(PUBLISH_COUNT, readCounts[ii] + subscribers.getMissedCount(handles[ii]));
+        TEST_ASSERT_GREATER_OR_EQUAL(PUBLISH_COUNT - 1, readCounts[ii] + subscribers.getMissedCount(handles[ii]));
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_subscribers);
+    RUN_TEST(test_receiver_subscribers_receiver_task);
+    RUN_TEST(test_receiver_subscribers_concurrent);
+
+    UNITY_END();
+}
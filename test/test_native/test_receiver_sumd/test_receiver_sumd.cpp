@@ -0,0 +1,136 @@
+#include "ReceiverSUMD.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+typedef std::array<uint8_t, ReceiverSUMD::MAX_FRAME_SIZE> frame_t;
+
+// channel values are in microseconds, returns the length of the frame
+static size_t makeFrame(frame_t& frame, uint8_t status, const uint16_t* channels, size_t channelCount)
+{
+    size_t pos = 0;
+    frame[pos++] = ReceiverSUMD::SUMD_HEADER_BYTE;
+    frame[pos++] = status;
+    frame[pos++] = static_cast<uint8_t>(channelCount);
+    for (size_t ii = 0; ii < channelCount; ++ii) {
+        const auto value = static_cast<uint16_t>(channels[ii] * 8U);
+        frame[pos++] = static_cast<uint8_t>(value >> 8U);
+        frame[pos++] = static_cast<uint8_t>(value);
+    }
+    const uint16_t crc = ReceiverSUMD::calculateCRC(&frame[0], pos);
+    frame[pos++] = static_cast<uint8_t>(crc >> 8U);
+    frame[pos++] = static_cast<uint8_t>(crc);
+    return pos;
+}
+
+static bool sendFrame(ReceiverSUMD& receiver, const frame_t& frame, size_t length)
+{
+    bool complete = false;
+    for (size_t ii = 0; ii < length; ++ii) {
+        complete = receiver.onDataReceivedFromISR(frame[ii]);
+    }
+    return complete;
+}
+
+void test_receiver_sumd()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 0, ReceiverSUMD::BAUD_RATE, ReceiverSUMD::DATA_BITS, ReceiverSUMD::STOP_BITS, ReceiverSUMD::PARITY);
+    static ReceiverSUMD receiver(serialPort);
+
+    TEST_ASSERT_EQUAL(ReceiverSUMD::CHANNEL_ORDER_TAER, receiver.getChannelOrder());
+
+    // channels are sent in TAER order
+    const std::array<uint16_t, 8> channels = { 1000, 1100, 1200, 1900, 2000, 1500, 1000, 1700 };
+    frame_t frame {};
+    size_t length = makeFrame(frame, ReceiverSUMD::STATUS_LIVE, &channels[0], channels.size());
+    TEST_ASSERT_EQUAL(21, length);
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame, length));
+    TEST_ASSERT_FALSE(receiver.isPacketEmpty());
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+    TEST_ASSERT_FALSE(receiver.isFailsafe());
+    TEST_ASSERT_EQUAL(8, receiver.getFrameChannelCount());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1200, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1900, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(1700, receiver.getChannelPWM(ReceiverBase::AUX4));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(ReceiverSUMD::CHANNEL_COUNT));
+
+    float throttle {};
+    float roll {};
+    float pitch {};
+    float yaw {};
+    receiver.getStickValues(throttle, roll, pitch, yaw);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, throttle);
+    TEST_ASSERT_EQUAL_FLOAT(-0.4F, roll);
+    TEST_ASSERT_EQUAL_FLOAT(0.4F, yaw);
+
+    // failsafe frame does not update channels
+    const std::array<uint16_t, 8> failsafeChannels = { 1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500 };
+    length = makeFrame(frame, ReceiverSUMD::STATUS_FAILSAFE, &failsafeChannels[0], failsafeChannels.size());
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame, length));
+    TEST_ASSERT_FALSE(receiver.unpackPacket());
+    TEST_ASSERT_TRUE(receiver.isFailsafe());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+
+    // frame with bad CRC is rejected in the ISR
+    length = makeFrame(frame, ReceiverSUMD::STATUS_LIVE, &failsafeChannels[0], failsafeChannels.size());
+    frame[length - 1] ^= 0x01;
+    TEST_ASSERT_FALSE(sendFrame(receiver, frame, length));
+    TEST_ASSERT_TRUE(receiver.isPacketEmpty());
+
+    // maximum size frame, channels beyond CHANNEL_COUNT are ignored
+    std::array<uint16_t, ReceiverSUMD::MAX_FRAME_CHANNEL_COUNT> allChannels {};
+    for (size_t ii = 0; ii < allChannels.size(); ++ii) {
+        allChannels[ii] = static_cast<uint16_t>(1000 + ii*10);
+    }
+    length = makeFrame(frame, ReceiverSUMD::STATUS_LIVE, &allChannels[0], allChannels.size());
+    TEST_ASSERT_EQUAL(69, length);
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame, length));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_FALSE(receiver.isFailsafe());
+    TEST_ASSERT_EQUAL(32, receiver.getFrameChannelCount());
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1010, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1040, receiver.getChannelPWM(ReceiverBase::AUX1));
+    TEST_ASSERT_EQUAL(1000 + (ReceiverSUMD::CHANNEL_COUNT - 1)*10, receiver.getChannelPWM(ReceiverSUMD::CHANNEL_COUNT - 1));
+}
+
+void test_receiver_sumd_channel_order_aetr()
+{
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, 1, ReceiverSUMD::BAUD_RATE, ReceiverSUMD::DATA_BITS, ReceiverSUMD::STOP_BITS, ReceiverSUMD::PARITY);
+    static ReceiverSUMD receiver(serialPort);
+    receiver.setChannelOrder(ReceiverSUMD::CHANNEL_ORDER_AETR);
+
+    // channels are sent in AETR order, so are not remapped
+    const std::array<uint16_t, 6> channels = { 1100, 1200, 1000, 1900, 2000, 1500 };
+    frame_t frame {};
+    const size_t length = makeFrame(frame, ReceiverSUMD::STATUS_LIVE, &channels[0], channels.size());
+    TEST_ASSERT_TRUE(sendFrame(receiver, frame, length));
+    TEST_ASSERT_TRUE(receiver.unpackPacket());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1200, receiver.getChannelPWM(ReceiverBase::PITCH));
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1900, receiver.getChannelPWM(ReceiverBase::YAW));
+    TEST_ASSERT_EQUAL(2000, receiver.getChannelPWM(ReceiverBase::AUX1));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_sumd);
+    RUN_TEST(test_receiver_sumd_channel_order_aetr);
+
+    UNITY_END();
+}
@@ -0,0 +1,238 @@
+#include "CockpitBase.h"
+#include "ReceiverTask.h"
+#include "ReceiverVirtual.h"
+#include "TaskSignal.h"
+
+#include <atomic>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class CockpitTest : public CockpitBase {
+public:
+    explicit CockpitTest(ReceiverBase& receiver) : CockpitBase(receiver) {}
+    virtual void updateControls(const controls_t& controls) override { _controls = controls; ++_updateCount; }
+    virtual void checkFailsafe(uint32_t tickCount) override { (void)tickCount; ++_failsafeCheckCount; }
+    const controls_t& getControls() const { return _controls; }
+    uint32_t getUpdateCount() const { return _updateCount; }
+    uint32_t getFailsafeCheckCount() const { return _failsafeCheckCount; }
+private:
+    controls_t _controls {};
+    uint32_t _updateCount {};
+    uint32_t _failsafeCheckCount {};
+};
+
+class ReceiverSignalled : public ReceiverVirtual {
+public:
+    virtual int32_t WAIT_FOR_DATA_RECEIVED(uint32_t ticksToWait) override { return _signal.WAIT(ticksToWait); }
+    void signal() { _signal.SIGNAL_FROM_ISR(); }
+private:
+    TaskSignal _signal;
+};
+
+void test_receiver_task_create()
+{
+    static ReceiverVirtual receiver;
+    static CockpitTest cockpit(receiver);
+    static ReceiverVirtual receiver2;
+    static CockpitTest cockpit2(receiver2);
+
+    // the unit-test env sets RECEIVER_TASK_MAX_COUNT=2
+    TaskBase::task_info_t taskInfo {};
+    ReceiverTask* receiverTask = ReceiverTask::createTask(taskInfo, receiver, cockpit, 3, 0, 1000);
+    TEST_ASSERT_NOT_NULL(receiverTask);
+    TEST_ASSERT_EQUAL_STRING("ReceiverTask", taskInfo.name);
+    TEST_ASSERT_NOT_NULL(taskInfo.stackBuffer);
+    TEST_ASSERT_EQUAL(1000, taskInfo.taskIntervalMicroseconds);
+
+    TaskBase::task_info_t taskInfo2 {};
+    ReceiverTask* receiverTask2 = ReceiverTask::createTask(taskInfo2, receiver2, cockpit2, 3, 0, 2000);
+    TEST_ASSERT_NOT_NULL(receiverTask2);
+    TEST_ASSERT_TRUE(receiverTask2 != receiverTask);
+    TEST_ASSERT_EQUAL_STRING("ReceiverTask1", taskInfo2.name);
+    TEST_ASSERT_NOT_NULL(taskInfo2.stackBuffer);
+    TEST_ASSERT_TRUE(taskInfo2.stackBuffer != taskInfo.stackBuffer);
+    TEST_ASSERT_EQUAL(2000, taskInfo2.taskIntervalMicroseconds);
+    // creating the second task does not rename the first
+    TEST_ASSERT_EQUAL_STRING("ReceiverTask", taskInfo.name);
+
+    // each task is bound to the receiver and cockpit it was created with
+    receiver.setControls({ .throttle = 0.25F, .roll = 0.0F, .pitch = 0.0F, .yaw = 0.0F });
+    receiverTask->loop();
+    TEST_ASSERT_EQUAL(1, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(0, cockpit2.getUpdateCount());
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, cockpit.getControls().throttleStick);
+
+    receiver2.setControls({ .throttle = 0.75F, .roll = 0.0F, .pitch = 0.0F, .yaw = 0.0F });
+    receiverTask2->loop();
+    TEST_ASSERT_EQUAL(1, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(1, cockpit2.getUpdateCount());
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, cockpit2.getControls().throttleStick);
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, cockpit.getControls().throttleStick);
+
+    // all slots used, so a third task is not created, rather than returning a task bound to another receiver
+    static ReceiverVirtual receiver3;
+    static CockpitTest cockpit3(receiver3);
+    TaskBase::task_info_t taskInfo3 {};
+    TEST_ASSERT_NULL(ReceiverTask::createTask(taskInfo3, receiver3, cockpit3, 3, 0, 1000));
+    TEST_ASSERT_NULL(taskInfo3.stackBuffer);
+    receiverTask->loop();
+    TEST_ASSERT_EQUAL(2, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(1, cockpit2.getUpdateCount());
+    TEST_ASSERT_EQUAL(0, cockpit3.getUpdateCount());
+}
+void test_receiver_task_thread_time_based()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    ReceiverTask receiverTask(2000, receiver, cockpit);
+
+    TEST_ASSERT_FALSE(receiverTask.isRunning());
+    TEST_ASSERT_TRUE(receiverTask.start());
+    TEST_ASSERT_TRUE(receiverTask.isRunning());
+    TEST_ASSERT_FALSE(receiverTask.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    receiverTask.stop();
+    TEST_ASSERT_FALSE(receiverTask.isRunning());
+
+    // ReceiverVirtual always has a new packet, so loop() updates the cockpit every 2ms
+    // allow for a heavily loaded machine, since the deadlines are absolute there should not be many more than 50 loops
+    const uint32_t updateCount = cockpit.getUpdateCount();
+    TEST_ASSERT_GREATER_OR_EQUAL(10, updateCount);
+    TEST_ASSERT_LESS_OR_EQUAL(52, updateCount);
+
+    // stopped task does not update the cockpit
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    TEST_ASSERT_EQUAL(updateCount, cockpit.getUpdateCount());
+    // and can be restarted
+    TEST_ASSERT_TRUE(receiverTask.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    receiverTask.stop();
+    TEST_ASSERT_GREATER_THAN(updateCount, cockpit.getUpdateCount());
+}
+
+void test_receiver_task_thread_sub_millisecond()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    ReceiverTask receiverTask(250, receiver, cockpit);
+
+    TEST_ASSERT_TRUE(receiverTask.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    receiverTask.stop();
+
+    // 400 loops expected, if the interval was rounded up to 1ms there would be at most 100
+    const uint32_t updateCount = cockpit.getUpdateCount();
+    TEST_ASSERT_GREATER_THAN(150, updateCount);
+    TEST_ASSERT_LESS_OR_EQUAL(402, updateCount);
+}
+
+void test_receiver_task_thread_external_timer()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    cockpit.setTimeoutTicks(5);
+    ReceiverTask receiverTask(250, receiver, cockpit);
+    receiverTask.setPeriodicTimerExternal();
+
+    // three timer periods elapse before the task runs, so one loop is run and two loops are counted as overruns
+    receiverTask.onPeriodicTimerFromISR();
+    receiverTask.onPeriodicTimerFromISR();
+    receiverTask.onPeriodicTimerFromISR();
+    TEST_ASSERT_TRUE(receiverTask.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST_ASSERT_EQUAL(1, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(2, receiverTask.getOverrunCount());
+
+    // timer drives the loop
+    for (size_t ii = 0; ii < 5; ++ii) {
+        receiverTask.onPeriodicTimerFromISR();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    receiverTask.stop();
+    TEST_ASSERT_GREATER_OR_EQUAL(2, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(6, cockpit.getUpdateCount() + receiverTask.getOverrunCount() - 2);
+    // no timer signals for 20ms, so failsafe was checked
+    TEST_ASSERT_GREATER_OR_EQUAL(1, cockpit.getFailsafeCheckCount());
+}
+
+void test_receiver_task_thread_event_driven()
+{
+    ReceiverSignalled receiver;
+    CockpitTest cockpit(receiver);
+    cockpit.setTimeoutTicks(5);
+    ReceiverTask receiverTask(0, receiver, cockpit);
+
+    TEST_ASSERT_TRUE(receiverTask.start());
+    // no data, so the task times out and checks failsafe
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    TEST_ASSERT_EQUAL(0, cockpit.getUpdateCount());
+
+    enum { FRAME_COUNT = 10 };
+    for (size_t ii = 0; ii < FRAME_COUNT; ++ii) {
+        receiver.signal();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    receiverTask.stop();
+
+    // signals that arrive while the task is busy are coalesced, so there may be fewer updates than frames
+    TEST_ASSERT_GREATER_OR_EQUAL(1, cockpit.getUpdateCount());
+    TEST_ASSERT_LESS_OR_EQUAL(FRAME_COUNT, cockpit.getUpdateCount());
+    TEST_ASSERT_GREATER_OR_EQUAL(2, cockpit.getFailsafeCheckCount());
+}
+
+void test_receiver_task_thread_predictive_wake()
+{
+    ReceiverSignalled receiver;
+    CockpitTest cockpit(receiver);
+    cockpit.setTimeoutTicks(5);
+    ReceiverTask receiverTask(1000, receiver, cockpit);
+    receiverTask.setPredictiveWake(true);
+
+    // frames every 4ms, with a steady phase
+    std::atomic<bool> sending {true};
+    std::thread sender([&receiver, &sending]() {
+        auto frameTime = std::chrono::steady_clock::now();
+        while (sending) {
+            frameTime += std::chrono::microseconds(4000);
+            std::this_thread::sleep_until(frameTime);
+            receiver.signal();
+        }
+    });
+    TEST_ASSERT_TRUE(receiverTask.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    receiverTask.stop();
+    sending = false;
+    sender.join();
+
+    const FramePredictor& predictor = receiverTask.getFramePredictor();
+    TEST_ASSERT_TRUE(predictor.isLocked());
+    TEST_ASSERT_GREATER_OR_EQUAL(3500, predictor.getPeriodUs());
+    TEST_ASSERT_LESS_OR_EQUAL(4500, predictor.getPeriodUs());
+    // polling at 1ms would give about 200 loops, predictive wake gives about one loop per frame once locked
+    TEST_ASSERT_GREATER_OR_EQUAL(30, cockpit.getUpdateCount());
+    TEST_ASSERT_LESS_THAN(150, cockpit.getUpdateCount());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_task_create);
+    RUN_TEST(test_receiver_task_thread_time_based);
+    RUN_TEST(test_receiver_task_thread_sub_millisecond);
+    RUN_TEST(test_receiver_task_thread_external_timer);
+    RUN_TEST(test_receiver_task_thread_event_driven);
+    RUN_TEST(test_receiver_task_thread_predictive_wake);
+
+    UNITY_END();
+}
@@ -0,0 +1,188 @@
+#include "CockpitBase.h"
+#include "ReceiverTask.h"
+#include "ReceiverTrace.h"
+#include "ReceiverTraceDecoder.h"
+#include "ReceiverVirtual.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+    ReceiverTrace::reset();
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class CockpitTest : public CockpitBase {
+public:
+    explicit CockpitTest(ReceiverBase& receiver) : CockpitBase(receiver) {}
+    virtual void updateControls(const controls_t& controls) override { (void)controls; }
+    virtual void checkFailsafe(uint32_t tickCount) override { (void)tickCount; }
+};
+
+void test_receiver_trace_record()
+{
+    std::array<ReceiverTrace::event_t, ReceiverTrace::SIZE> events {};
+    TEST_ASSERT_EQUAL(0, ReceiverTrace::dump(&events[0], events.size()));
+
+    RECEIVER_TRACE(ISR_BYTE_BURST, 16);
+    RECEIVER_TRACE(FRAME_COMPLETE, 0);
+    RECEIVER_TRACE(TASK_WAKE, 1);
+    TEST_ASSERT_EQUAL(3, ReceiverTrace::getRecordCount());
+
+    TEST_ASSERT_EQUAL(3, ReceiverTrace::dump(&events[0], events.size()));
+    TEST_ASSERT_EQUAL(ReceiverTrace::ISR_BYTE_BURST, events[0].type);
+    TEST_ASSERT_EQUAL(16, events[0].arg);
+    TEST_ASSERT_EQUAL(ReceiverTrace::FRAME_COMPLETE, events[1].type);
+    TEST_ASSERT_EQUAL(ReceiverTrace::TASK_WAKE, events[2].type);
+    TEST_ASSERT_EQUAL(1, events[2].arg);
+    TEST_ASSERT_TRUE(static_cast<int32_t>(events[2].timeUs - events[0].timeUs) >= 0);
+
+    // when the output is smaller than the trace, the most recent events are returned
+    TEST_ASSERT_EQUAL(2, ReceiverTrace::dump(&events[0], 2));
+    TEST_ASSERT_EQUAL(ReceiverTrace::FRAME_COMPLETE, events[0].type);
+    TEST_ASSERT_EQUAL(ReceiverTrace::TASK_WAKE, events[1].type);
+}
+
+void test_receiver_trace_wrap()
+{
+    // write more than the size of the ring, the oldest events are overwritten
+    for (uint32_t ii = 0; ii < ReceiverTrace::SIZE + 10; ++ii) {
+        RECEIVER_TRACE(COCKPIT_UPDATE, ii);
+    }
+    std::array<ReceiverTrace::event_t, ReceiverTrace::SIZE> events {};
+    TEST_ASSERT_EQUAL(ReceiverTrace::SIZE, ReceiverTrace::dump(&events[0], events.size()));
+    for (uint32_t ii = 0; ii < ReceiverTrace::SIZE; ++ii) {
+        TEST_ASSERT_EQUAL(ReceiverTrace::COCKPIT_UPDATE, events[ii].type);
+        TEST_ASSERT_EQUAL(ii + 10, events[ii].arg);
+    }
+}
+
+void test_receiver_trace_task_loop()
+{
+    ReceiverVirtual receiver;
+    CockpitTest cockpit(receiver);
+    ReceiverTask receiverTask(1000, receiver, cockpit);
+
+    receiverTask.loop();
+    std::array<ReceiverTrace::event_t, 8> events {};
+    TEST_ASSERT_EQUAL(1, ReceiverTrace::dump(&events[0], events.size()));
+    TEST_ASSERT_EQUAL(ReceiverTrace::COCKPIT_UPDATE, events[0].type);
+}
+
+void test_receiver_trace_concurrent()
+{
+    // two producers, standing in for an ISR and a task, write while a consumer dumps
+    enum { EVENTS_PER_PRODUCER = 20000 };
+    std::atomic<bool> done {false};
+    std::atomic<uint32_t> invalidCount {0};
+    std::thread consumer([&]() {
+        std::array<ReceiverTrace::event_t, ReceiverTrace::SIZE> events {};
+        while (!done) {
+            const size_t count = ReceiverTrace::dump(&events[0], events.size());
+            std::array<int32_t, 2> previousArg { -1, -1 };
+            for (size_t ii = 0; ii < count; ++ii) {
+                const ReceiverTrace::event_t& event = events[ii];
+                if (event.type != ReceiverTrace::ISR_BYTE_BURST && event.type != ReceiverTrace::TASK_WAKE) {
+                    ++invalidCount;
+                    continue;
+                }
+                // each producer's events are in order
+                const size_t producer = event.type == ReceiverTrace::ISR_BYTE_BURST ? 0 : 1;
+                if (static_cast<int32_t>(event.arg) <= previousArg[producer]) {
+                    ++invalidCount;
+                }
+                previousArg[producer] = event.arg;
+            }
+        }
+    });
+    std::thread isr([]() {
+        for (uint32_t ii = 0; ii < EVENTS_PER_PRODUCER; ++ii) {
+            RECEIVER_TRACE(ISR_BYTE_BURST, ii);
+        }
+    });
+    std::thread task([]() {
+        for (uint32_t ii = 0; ii < EVENTS_PER_PRODUCER; ++ii) {
+            RECEIVER_TRACE(TASK_WAKE, ii);
+        }
+    });
+    isr.join();
+    task.join();
+    done = true;
+    consumer.join();
+
+    TEST_ASSERT_EQUAL(0, invalidCount.load());
+    TEST_ASSERT_EQUAL(2 * EVENTS_PER_PRODUCER, ReceiverTrace::getRecordCount());
+}
+
+void test_receiver_trace_decoder()
+{
+    std::array<ReceiverTrace::event_t, 4> events {{
+        { .timeUs = 0xFFFFFF00, .type = ReceiverTrace::ISR_BYTE_BURST, .reserved = 0, .arg = 8 },
+        { .timeUs = 0xFFFFFF10, .type = ReceiverTrace::CRC_FAILURE, .reserved = 0, .arg = 0 },
+        // time wraps
+        { .timeUs = 0x00000010, .type = ReceiverTrace::TASK_WAKE, .reserved = 0, .arg = 1 },
+        { .timeUs = 0x00000020, .type = ReceiverTrace::FAILSAFE_CHECK, .reserved = 0, .arg = 0 },
+    }};
+    std::array<char, 2048> json {};
+    const size_t length = ReceiverTraceDecoder::toChromeTraceJSON(&json[0], json.size(), &events[0], events.size());
+    TEST_ASSERT_LESS_THAN(json.size(), length);
+    TEST_ASSERT_EQUAL(length, std::strlen(&json[0]));
+
+    TEST_ASSERT_EQUAL(0, std::strncmp(&json[0], "{\"traceEvents\":[", 16));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "{\"name\":\"ISR byte burst\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":1,\"tid\":1,\"args\":{\"arg\":8}}"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"CRC failure\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":16,\"pid\":1,\"tid\":2,"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"task wake\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":272,\"pid\":1,\"tid\":3,"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"failsafe check\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":288,"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"args\":{\"name\":\"UART ISR\"}"));
+    TEST_ASSERT_EQUAL_STRING("\n]}\n", &json[length - 4]);
+
+    // too small a buffer truncates the JSON, but still returns the length needed
+    std::array<char, 32> small {};
+    TEST_ASSERT_EQUAL(length, ReceiverTraceDecoder::toChromeTraceJSON(&small[0], small.size(), &events[0], events.size()));
+    TEST_ASSERT_EQUAL(small.size() - 1, std::strlen(&small[0]));
+}
+
+void test_receiver_trace_decoder_out_of_order()
+{
+    // an ISR may record an event with a later slot but an earlier time than the event before it
+    std::array<ReceiverTrace::event_t, 4> events {{
+        { .timeUs = 1000, .type = ReceiverTrace::TASK_WAKE, .reserved = 0, .arg = 1 },
+        { .timeUs = 995, .type = ReceiverTrace::ISR_BYTE_BURST, .reserved = 0, .arg = 16 },
+        { .timeUs = 1010, .type = ReceiverTrace::COCKPIT_UPDATE, .reserved = 0, .arg = 0 },
+        { .timeUs = 1005, .type = ReceiverTrace::FRAME_COMPLETE, .reserved = 0, .arg = 0 },
+    }};
+    TEST_ASSERT_EQUAL(-5, ReceiverTraceDecoder::intervalUs(events[0], events[1]));
+
+    std::array<char, 2048> json {};
+    const size_t length = ReceiverTraceDecoder::toChromeTraceJSON(&json[0], json.size(), &events[0], events.size());
+    TEST_ASSERT_LESS_THAN(json.size(), length);
+
+    // timestamps are from the earliest event, not the first event
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"task wake\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":5,"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"ISR byte burst\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"cockpit update\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":15,"));
+    TEST_ASSERT_NOT_NULL(std::strstr(&json[0], "\"name\":\"frame complete\",\"cat\":\"receiver\",\"ph\":\"i\",\"s\":\"t\",\"ts\":10,"));
+    TEST_ASSERT_NULL(std::strstr(&json[0], "\"ts\":-"));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_receiver_trace_record);
+    RUN_TEST(test_receiver_trace_wrap);
+    RUN_TEST(test_receiver_trace_task_loop);
+    RUN_TEST(test_receiver_trace_concurrent);
+    RUN_TEST(test_receiver_trace_decoder);
+    RUN_TEST(test_receiver_trace_decoder_out_of_order);
+
+    UNITY_END();
+}
@@ -0,0 +1,145 @@
+#include "ReceiverUDP.h"
+
+#include <unity.h>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+#if defined(__linux__)
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,cppcoreguidelines-pro-type-reinterpret-cast,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+class Sender {
+public:
+    explicit Sender(uint16_t port) : _socket(socket(AF_INET, SOCK_DGRAM, 0)) {
+        _address.sin_family = AF_INET;
+        _address.sin_port = htons(port);
+        _address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    }
+    ~Sender() { close(_socket); }
+    Sender(const Sender&) = delete;
+    Sender& operator=(const Sender&) = delete;
+    void send(const uint8_t* buf, size_t length) const {
+        sendto(_socket, buf, length, 0, reinterpret_cast<const sockaddr*>(&_address), sizeof(_address));
+    }
+    void sendFrame(uint32_t sequence, uint16_t roll) const {
+        const std::array<uint16_t, 8> channels = { roll, 1500, 1000, 1500, 1100, 1200, 1300, 1400 };
+        std::array<uint8_t, ReceiverUDP::MAX_FRAME_SIZE> buf {};
+        const size_t length = ReceiverUDP::packFrame(&buf[0], sequence, &channels[0], channels.size());
+        send(&buf[0], length);
+    }
+private:
+    int _socket;
+    sockaddr_in _address {};
+};
+
+void test_receiver_udp()
+{
+    static ReceiverUDP receiver(0, INADDR_LOOPBACK);
+    TEST_ASSERT_TRUE(receiver.init());
+    TEST_ASSERT_NOT_EQUAL(0, receiver.getPort());
+    const Sender sender(receiver.getPort());
+
+    TEST_ASSERT_EQUAL(0, receiver.WAIT_FOR_DATA_RECEIVED(0));
+    TEST_ASSERT_FALSE(receiver.update(0));
+
+    sender.sendFrame(1, 1100);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(1, receiver.getSequence());
+    TEST_ASSERT_EQUAL(8, receiver.getChannelCount());
+    TEST_ASSERT_EQUAL(4, receiver.getAuxiliaryChannelCount());
+    TEST_ASSERT_EQUAL(1100, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(1000, receiver.getChannelPWM(ReceiverBase::THROTTLE));
+    TEST_ASSERT_EQUAL(1400, receiver.getChannelPWM(ReceiverBase::AUX4));
+    TEST_ASSERT_EQUAL(ReceiverBase::CHANNEL_LOW, receiver.getChannelPWM(8));
+    TEST_ASSERT_TRUE(receiver.isNewPacketAvailable());
+
+    // several queued frames, only newest is used
+    sender.sendFrame(2, 1200);
+    sender.sendFrame(3, 1300);
+    sender.sendFrame(4, 1400);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(4, receiver.getSequence());
+    TEST_ASSERT_EQUAL(1400, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_EQUAL(2, receiver.getSupersededFrameCount());
+    TEST_ASSERT_EQUAL(0, receiver.getDroppedPacketCountDelta());
+
+    // stale and invalid frames are discarded
+    sender.sendFrame(3, 1500);
+    const std::array<uint8_t, 4> garbage = { 1, 2, 3, 4 };
+    sender.send(&garbage[0], garbage.size());
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_FALSE(receiver.update(0));
+    TEST_ASSERT_EQUAL(1, receiver.getStaleFrameCount());
+    TEST_ASSERT_EQUAL(1, receiver.getInvalidFrameCount());
+    TEST_ASSERT_EQUAL(1400, receiver.getChannelPWM(ReceiverBase::ROLL));
+
+    // gap in sequence is counted as dropped
+    sender.sendFrame(7, 1700);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(2, receiver.getDroppedPacketCountDelta());
+
+    // more frames than one batch
+    for (uint32_t ii = 0; ii < 2*ReceiverUDP::BATCH_SIZE + 3; ++ii) {
+        sender.sendFrame(8 + ii, static_cast<uint16_t>(1000 + ii));
+    }
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(8 + 2*ReceiverUDP::BATCH_SIZE + 2, receiver.getSequence());
+    TEST_ASSERT_EQUAL(1000 + 2*ReceiverUDP::BATCH_SIZE + 2, receiver.getChannelPWM(ReceiverBase::ROLL));
+    TEST_ASSERT_FALSE(receiver.update(0));
+
+    // sequence number wraps around
+    sender.sendFrame(0xFFFFFFFF, 1234);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_FALSE(receiver.update(0)); // more than half the sequence range away, so older
+    sender.sendFrame(0x7FFFFFF0, 1234);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    sender.sendFrame(0xBFFFFFF0, 1234);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    sender.sendFrame(0xFFFFFFF0, 1234);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    sender.sendFrame(0x00000002, 1555);
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(2, receiver.getSequence());
+    TEST_ASSERT_EQUAL(1555, receiver.getChannelPWM(ReceiverBase::ROLL));
+
+    // sender restarts its sequence, receiver resynchronizes after RESYNC_STALE_FRAME_COUNT stale frames
+    for (uint32_t ii = 0; ii < ReceiverUDP::RESYNC_STALE_FRAME_COUNT + 2; ++ii) {
+        sender.sendFrame(0xFFFFFF00 + ii, static_cast<uint16_t>(1100 + ii));
+    }
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(100));
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(0xFFFFFF00 + ReceiverUDP::RESYNC_STALE_FRAME_COUNT + 1, receiver.getSequence());
+    TEST_ASSERT_EQUAL(1100 + ReceiverUDP::RESYNC_STALE_FRAME_COUNT + 1, receiver.getChannelPWM(ReceiverBase::ROLL));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,cppcoreguidelines-pro-type-reinterpret-cast,misc-const-correctness,readability-convert-member-functions-to-static,readability-magic-numbers)
+#endif // __linux__
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+#if defined(__linux__)
+    RUN_TEST(test_receiver_udp);
+#endif
+
+    UNITY_END();
+}
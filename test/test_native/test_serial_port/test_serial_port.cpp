@@ -0,0 +1,81 @@
+#include "SerialPort.h"
+
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class SerialPortWatcherTest : public SerialPortWatcherBase {
+public:
+    virtual bool onDataReceivedFromISR(uint8_t data) override { _lastData = data; ++_count; return true; }
+    uint8_t getLastData() const { return _lastData; }
+    uint32_t getCount() const { return _count; }
+private:
+    uint8_t _lastData {};
+    uint32_t _count {};
+};
+
+void test_serial_port_instances()
+{
+    TEST_ASSERT_NULL(SerialPort::getInstance(SerialPort::UART_INDEX_0));
+    TEST_ASSERT_NULL(SerialPort::getInstance(SerialPort::UART_COUNT));
+    // no instance, so ISR does nothing
+    SerialPort::dataReadyISR(SerialPort::UART_INDEX_1);
+    SerialPort::dataReadyISR(SerialPort::UART_COUNT);
+
+    SerialPortWatcherTest watcher0;
+    SerialPortWatcherTest watcher2;
+    {
+        SerialPort serialPort0(&watcher0, SerialPort::serial_pins_t{}, SerialPort::UART_INDEX_0, 115200, 8, 1, SerialPort::PARITY_NONE);
+        SerialPort serialPort2(&watcher2, SerialPort::serial_pins_t{}, SerialPort::UART_INDEX_2, 420000, 8, 1, SerialPort::PARITY_NONE);
+        // instances are registered by init()
+        TEST_ASSERT_NULL(SerialPort::getInstance(SerialPort::UART_INDEX_0));
+        serialPort0.init();
+        serialPort2.init();
+        TEST_ASSERT_EQUAL_PTR(&serialPort0, SerialPort::getInstance(SerialPort::UART_INDEX_0));
+        TEST_ASSERT_NULL(SerialPort::getInstance(SerialPort::UART_INDEX_1));
+        TEST_ASSERT_EQUAL_PTR(&serialPort2, SerialPort::getInstance(SerialPort::UART_INDEX_2));
+        TEST_ASSERT_EQUAL(2, serialPort2.getUartIndex());
+        TEST_ASSERT_EQUAL(420000, SerialPort::getInstance(SerialPort::UART_INDEX_2)->getBaudrate());
+
+        // each instance dispatches to its own watcher
+        TEST_ASSERT_TRUE(SerialPort::getInstance(SerialPort::UART_INDEX_0)->onDataReceivedFromISR(0x12));
+        TEST_ASSERT_TRUE(SerialPort::getInstance(SerialPort::UART_INDEX_2)->onDataReceivedFromISR(0x34));
+        TEST_ASSERT_EQUAL(0x12, watcher0.getLastData());
+        TEST_ASSERT_EQUAL(1, watcher0.getCount());
+        TEST_ASSERT_EQUAL(0x34, watcher2.getLastData());
+        TEST_ASSERT_EQUAL(1, watcher2.getCount());
+
+        // each ISR signals only its own instance
+        SerialPort::dataReadyISR(SerialPort::UART_INDEX_0);
+        TEST_ASSERT_EQUAL(1, serialPort0.WAIT_DATA_READY(0));
+        TEST_ASSERT_EQUAL(0, serialPort2.WAIT_DATA_READY(0));
+        SerialPort::dataReadyISR(SerialPort::UART_INDEX_2);
+        SerialPort::dataReadyISR(SerialPort::UART_INDEX_2);
+        TEST_ASSERT_EQUAL(0, serialPort0.WAIT_DATA_READY(0));
+        TEST_ASSERT_EQUAL(2, serialPort2.WAIT_DATA_READY(0));
+        // no instance for UART 1, so nothing is signalled
+        SerialPort::dataReadyISR(SerialPort::UART_INDEX_1);
+        TEST_ASSERT_EQUAL(0, serialPort0.WAIT_DATA_READY(0));
+        TEST_ASSERT_EQUAL(0, serialPort2.WAIT_DATA_READY(0));
+    }
+    // instances are deregistered when destroyed
+    TEST_ASSERT_NULL(SerialPort::getInstance(SerialPort::UART_INDEX_0));
+    TEST_ASSERT_NULL(SerialPort::getInstance(SerialPort::UART_INDEX_2));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_serial_port_instances);
+
+    UNITY_END();
+}
@@ -0,0 +1,172 @@
+#include "ByteRing.h"
+#include "CockpitBase.h"
+#include "ReceiverCRSF.h"
+#include "ReceiverTask.h"
+
+#include <atomic>
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+class CockpitTest : public CockpitBase {
+public:
+    explicit CockpitTest(ReceiverBase& receiver) : CockpitBase(receiver) {}
+    virtual void updateControls(const controls_t& controls) override {
+        (void)controls;
+        _lastChannel = _receiver.getChannelPWM(ReceiverBase::AUX1);
+        ++_updateCount;
+    }
+    virtual void checkFailsafe(uint32_t tickCount) override { (void)tickCount; }
+    uint32_t getUpdateCount() const { return _updateCount; }
+    uint16_t getLastChannel() const { return _lastChannel; }
+private:
+    std::atomic<uint32_t> _updateCount {};
+    std::atomic<uint16_t> _lastChannel {};
+};
+
+/*!
+Makes a CRSF RC channels frame, with channel 4 (AUX1) set to auxValue and all other channels at mid range.
+*/
+static size_t makeChannelsFrame(std::array<uint8_t, 26>& frame, uint16_t auxValue)
+{
+    enum { CHANNEL_COUNT = 16, CRSF_MID = 992 };
+    std::array<uint8_t, 22> payload {};
+    uint32_t bitIndex = 0;
+    for (size_t ii = 0; ii < CHANNEL_COUNT; ++ii) {
+        const uint32_t value = ii == ReceiverBase::AUX1 ? auxValue : static_cast<uint32_t>(CRSF_MID);
+        for (uint32_t bit = 0; bit < 11; ++bit, ++bitIndex) {
+            if (value & (1U << bit)) {
+                payload[bitIndex / 8] |= static_cast<uint8_t>(1U << (bitIndex % 8));
+            }
+        }
+    }
+    frame[0] = ReceiverCRSF::CRSF_SYNC_BYTE;
+    frame[1] = 24;
+    frame[2] = ReceiverCRSF::FRAMETYPE_RC_CHANNELS_PACKED;
+    uint8_t crc = ReceiverCRSF::calculateCRC(0, frame[2]);
+    for (size_t ii = 0; ii < payload.size(); ++ii) {
+        frame[3 + ii] = payload[ii];
+        crc = ReceiverCRSF::calculateCRC(crc, payload[ii]);
+    }
+    frame[25] = crc;
+    return frame.size();
+}
+
+void test_byte_ring()
+{
+    static ByteRing ring;
+    uint8_t data {};
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_FALSE(ring.pop(data));
+
+    for (size_t ii = 0; ii < ByteRing::SIZE; ++ii) {
+        TEST_ASSERT_TRUE(ring.push(static_cast<uint8_t>(ii)));
+    }
+    TEST_ASSERT_EQUAL(ByteRing::SIZE, ring.available());
+    TEST_ASSERT_FALSE(ring.push(0xAA));
+    TEST_ASSERT_EQUAL(1, ring.getOverflowCount());
+
+    for (size_t ii = 0; ii < ByteRing::SIZE; ++ii) {
+        TEST_ASSERT_TRUE(ring.pop(data));
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(ii), data);
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_serial_port_deferred()
+{
+    static ByteRing ring;
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, SerialPort::UART_INDEX_0, 420000, ReceiverCRSF::DATA_BITS, ReceiverCRSF::STOP_BITS, ReceiverCRSF::PARITY);
+    serialPort.setDeferredRing(&ring);
+    static ReceiverCRSF receiver(serialPort);
+    TEST_ASSERT_TRUE(serialPort.isDeferred());
+
+    std::array<uint8_t, 26> frame {};
+    const size_t length = makeChannelsFrame(frame, 1811);
+    // ISR pushes the bytes, but does not parse them
+    for (size_t ii = 0; ii < length; ++ii) {
+        TEST_ASSERT_TRUE(serialPort.receiveByteFromISR(frame[ii]));
+    }
+    TEST_ASSERT_EQUAL(0, receiver.getPacketIndex());
+    TEST_ASSERT_EQUAL(length, ring.available());
+    TEST_ASSERT_TRUE(serialPort.isDataAvailable());
+
+    // parsed when the receiver task waits
+    serialPort.SIGNAL_DATA_READY_FROM_ISR();
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(0));
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_TRUE(receiver.update(0));
+    TEST_ASSERT_EQUAL(2012, receiver.getChannelPWM(ReceiverBase::AUX1));
+
+    // partial frame does not complete a packet
+    for (size_t ii = 0; ii < 10; ++ii) {
+        serialPort.receiveByteFromISR(frame[ii]);
+    }
+    serialPort.SIGNAL_DATA_READY_FROM_ISR();
+    TEST_ASSERT_EQUAL(0, receiver.WAIT_FOR_DATA_RECEIVED(0));
+    for (size_t ii = 10; ii < length; ++ii) {
+        serialPort.receiveByteFromISR(frame[ii]);
+    }
+    serialPort.SIGNAL_DATA_READY_FROM_ISR();
+    TEST_ASSERT_EQUAL(1, receiver.WAIT_FOR_DATA_RECEIVED(0));
+}
+
+/*!
+Emulates the dual core split: one thread stands in for the UART ISR core, the ReceiverTask thread parses on the other core.
+*/
+void test_serial_port_deferred_two_threads()
+{
+    static ByteRing ring;
+    static SerialPort serialPort(SerialPort::uart_pins_t{}, SerialPort::UART_INDEX_1, 420000, ReceiverCRSF::DATA_BITS, ReceiverCRSF::STOP_BITS, ReceiverCRSF::PARITY);
+    serialPort.setDeferredRing(&ring);
+    static ReceiverCRSF receiver(serialPort);
+    static CockpitTest cockpit(receiver);
+    cockpit.setTimeoutTicks(5);
+    static ReceiverTask receiverTask(0, receiver, cockpit);
+    TEST_ASSERT_TRUE(receiverTask.start());
+
+    enum { FRAME_COUNT = 50, BURST_SIZE = 8 };
+    std::thread isrCore([]() {
+        std::array<uint8_t, 26> frame {};
+        for (uint16_t ii = 0; ii < FRAME_COUNT; ++ii) {
+            const size_t length = makeChannelsFrame(frame, static_cast<uint16_t>(200 + ii));
+            // bytes arrive in FIFO sized bursts, with one signal per burst
+            for (size_t jj = 0; jj < length; ++jj) {
+                serialPort.receiveByteFromISR(frame[jj]);
+                if (jj % BURST_SIZE == BURST_SIZE - 1 || jj == length - 1) {
+                    serialPort.SIGNAL_DATA_READY_FROM_ISR();
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    });
+    isrCore.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    receiverTask.stop();
+
+    TEST_ASSERT_EQUAL(0, ring.getOverflowCount());
+    TEST_ASSERT_EQUAL(FRAME_COUNT, cockpit.getUpdateCount());
+    TEST_ASSERT_EQUAL(receiver.getChannelPWM(ReceiverBase::AUX1), cockpit.getLastChannel());
+    // channel value 249 maps to 1036us
+    TEST_ASSERT_EQUAL(static_cast<uint16_t>(0.62477120195241F * 249.0F + 880.53935326418548F), cockpit.getLastChannel());
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_byte_ring);
+    RUN_TEST(test_serial_port_deferred);
+    RUN_TEST(test_serial_port_deferred_two_threads);
+
+    UNITY_END();
+}
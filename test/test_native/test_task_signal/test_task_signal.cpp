@@ -0,0 +1,66 @@
+#include "TaskSignal.h"
+
+#include <thread>
+#include <unity.h>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+void test_task_signal()
+{
+    TaskSignal signal;
+    // nothing signalled, so times out
+    TEST_ASSERT_EQUAL(0, signal.WAIT(0));
+    TEST_ASSERT_EQUAL(0, signal.WAIT(2));
+
+    // WAIT returns the number of signals since the last WAIT
+    signal.SIGNAL_FROM_ISR();
+    TEST_ASSERT_EQUAL(1, signal.WAIT(0));
+    TEST_ASSERT_EQUAL(0, signal.WAIT(0));
+    signal.SIGNAL_FROM_ISR();
+    signal.SIGNAL_FROM_ISR();
+    signal.SIGNAL_FROM_ISR();
+    TEST_ASSERT_EQUAL(3, signal.WAIT(10));
+    TEST_ASSERT_EQUAL(0, signal.WAIT(0));
+}
+
+void test_task_signal_thread()
+{
+    TaskSignal signal;
+    enum { SIGNAL_COUNT = 1000 };
+    std::thread isr([&signal]() {
+        for (size_t ii = 0; ii < SIGNAL_COUNT; ++ii) {
+            signal.SIGNAL_FROM_ISR();
+        }
+    });
+    uint32_t total = 0;
+    while (total < SIGNAL_COUNT) {
+        const int32_t count = signal.WAIT(1000);
+        TEST_ASSERT_GREATER_THAN(0, count);
+        if (count == 0) {
+            break;
+        }
+        total += static_cast<uint32_t>(count);
+    }
+    isr.join();
+    // no signals lost
+    TEST_ASSERT_EQUAL(SIGNAL_COUNT, total);
+    TEST_ASSERT_EQUAL(0, signal.WAIT(0));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,misc-const-correctness,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_task_signal);
+    RUN_TEST(test_task_signal_thread);
+
+    UNITY_END();
+}